@@ -1,31 +1,18 @@
 #pragma once
 
+#include "../game/Action.hpp"
 #include "State.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
-#include <vector>
 
 namespace blackjack {
 namespace ai {
 
-enum class Action : uint8_t { HIT = 0, STAND = 1, DOUBLE = 2, SPLIT = 3, SURRENDER = 4 };
-
-inline std::string actionToString(Action action) {
-  switch (action) {
-  case Action::HIT:
-    return "HIT";
-  case Action::STAND:
-    return "STAND";
-  case Action::DOUBLE:
-    return "DOUBLE";
-  case Action::SPLIT:
-    return "SPLIT";
-  case Action::SURRENDER:
-    return "SURRENDER";
-  default:
-    return "UNKNOWN";
-  }
-}
+using blackjack::Action;
+using blackjack::ActionMask;
+using blackjack::actionToString;
 
 /** One step: (state, action, reward, next_state, done, valid_next_actions). */
 struct Experience {
@@ -34,12 +21,12 @@ struct Experience {
   double reward;
   State nextState;
   bool done;
-  std::vector<Action> validNextActions;
+  ActionMask validNextActions;
 
   Experience(const State &s, Action a, double r, const State &ns, bool d,
-             std::vector<Action> vna = {})
+             ActionMask vna = {})
       : state(s), action(a), reward(r), nextState(ns), done(d),
-        validNextActions(std::move(vna)) {}
+        validNextActions(vna) {}
 };
 
 /** Base interface for learning agents. */
@@ -49,10 +36,33 @@ public:
 
   /** training: true = may explore, false = exploit only. */
   virtual Action chooseAction(const State &state,
-                              const std::vector<Action> &validActions,
+                              ActionMask validActions,
                               bool training = true) = 0;
 
+  /** chooseAction() for n states at once (a VectorEnv's batch): actions[i]
+   *  answers states[i]. Agents override it to amortize per-call work. */
+  virtual void chooseActions(const State *states,
+                             const ActionMask *validActions, Action *actions,
+                             size_t n, bool training = true) {
+    for (size_t i = 0; i < n; ++i) {
+      actions[i] = chooseAction(states[i], validActions[i], training);
+    }
+  }
+
   virtual void learn(const Experience &experience) = 0;
+
+  /** learn() over n experiences in order, typically a replay sample.
+   *  Agents override it to amortize per-call work and to leave step-based
+   *  schedules (exploration decay) to learn(), i.e. to fresh experience. */
+  virtual void learnBatch(const Experience *experiences, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      learn(experiences[i]);
+    }
+  }
+  /** False if learnBatch() cannot take experiences out of episode order
+   *  (e.g. an every-visit return needs whole episodes); callers then leave
+   *  experience replay off. */
+  virtual bool supportsReplay() const { return true; }
   virtual double getQValue(const State &state, Action action) const = 0;
   virtual void save(const std::string &filepath) const = 0;
   virtual void load(const std::string &filepath) = 0;
@@ -60,6 +70,29 @@ public:
 
   virtual double getExplorationRate() const { return 0.0; }
   virtual size_t getStateCount() const { return 0; }
+
+  /** Whether getVisitCount() reports how often each (state, action) has
+   *  been learned from; a confidence signal for the learned values. */
+  virtual bool countsVisits() const { return false; }
+  virtual double getVisitCount(const State &, Action) const { return 0.0; }
+
+  /** Switch to a mode where chooseAction()/learn() may be called from several
+   *  threads at once. @return false if the agent cannot be shared. */
+  virtual bool enableConcurrentLearning() { return false; }
+
+  /** Independent frozen copy for evaluating while this agent keeps learning.
+   *  @return nullptr if the agent cannot be copied. */
+  virtual std::unique_ptr<Agent> snapshot() const { return nullptr; }
+
+  /** True if the agent keys on State::trueCount; callers then fill it from
+   *  the game's Hi-Lo count (otherwise it stays 0). */
+  virtual bool usesTrueCount() const { return false; }
+
+  /** Restart the generator the calling thread explores with (the agent's
+   *  own, or under concurrent learning this thread's) at stream `stream` of
+   *  seed, making chooseAction(training=true) reproducible. Agents without
+   *  randomness ignore it. */
+  virtual void seed(uint32_t /*seed*/, uint64_t /*stream*/ = 0) {}
 };
 } // namespace ai
 } // namespace blackjack
\ No newline at end of file
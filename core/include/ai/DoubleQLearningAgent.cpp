@@ -0,0 +1,219 @@
+#include "DoubleQLearningAgent.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace blackjack {
+namespace ai {
+
+template <typename Table>
+BasicDoubleQLearningAgent<Table>::BasicDoubleQLearningAgent(
+    const Hyperparameters &params)
+    : params_(params), tableA_(0.0), tableB_(0.0), epsilon_(params.epsilon),
+      temperature_(params.exploration.temperature), rng_(randomSeed()) {
+  if (!params_.isValid()) {
+    throw std::invalid_argument("Invalid hyperparameters");
+  }
+}
+
+template <typename Table>
+BasicDoubleQLearningAgent<Table>::BasicDoubleQLearningAgent(
+    const BasicDoubleQLearningAgent &other)
+    : params_(other.params_), tableA_(other.tableA_), tableB_(other.tableB_),
+      epsilon_(other.getEpsilon()), temperature_(other.getTemperature()),
+      rng_(other.rng_),
+      stepCount_(other.stepCount_) {}
+
+template <typename Table>
+Action BasicDoubleQLearningAgent<Table>::chooseAction(const State &state,
+                                                      ActionMask validActions,
+                                                      bool training) {
+  if (validActions.empty()) {
+    throw std::invalid_argument("No valid actions provided");
+  }
+
+  if (!training) {
+    return greedyAction(state, validActions);
+  }
+  if (!params_.exploration.decaysEpsilon()) {
+    ActionVisits visits;
+    for (size_t i = 0; i < visits.size(); ++i) {
+      visits[i] = getVisitCount(state, static_cast<Action>(i));
+    }
+    return exploreAction(params_.exploration, getAllQValues(state), visits,
+                         validActions, getEpsilon(), getTemperature(),
+                         params_.epsilonMin, rng_);
+  }
+
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  if (dist(rng_) < getEpsilon()) {
+    return validActions.nth(
+        boundedRandom(rng_, static_cast<uint32_t>(validActions.size())));
+  }
+  return greedyAction(state, validActions);
+}
+
+template <typename Table>
+Action BasicDoubleQLearningAgent<Table>::greedyAction(
+    const State &state, ActionMask validActions) const {
+  // Argmax of Q_A + Q_B; ties go to the lowest action, as in the tables
+  const QValues a = tableA_.getAll(state);
+  const QValues b = tableB_.getAll(state);
+  Action best = validActions.front();
+  double bestValue = a[static_cast<size_t>(best)] + b[static_cast<size_t>(best)];
+  for (Action action : validActions) {
+    double value =
+        a[static_cast<size_t>(action)] + b[static_cast<size_t>(action)];
+    if (value > bestValue) {
+      best = action;
+      bestValue = value;
+    }
+  }
+  return best;
+}
+
+template <typename Table>
+void BasicDoubleQLearningAgent<Table>::learn(const Experience &experience) {
+  update(experience);
+  const ExplorationParams &exploration = params_.exploration;
+  if (exploration.decaysEpsilon()) {
+    epsilon_.store(std::max(getEpsilon() * params_.epsilonDecay,
+                            params_.epsilonMin),
+                   std::memory_order_relaxed);
+  } else if (exploration.decaysTemperature()) {
+    temperature_.store(std::max(getTemperature() * exploration.temperatureDecay,
+                                exploration.temperatureMin),
+                       std::memory_order_relaxed);
+  }
+  ++stepCount_;
+}
+
+template <typename Table>
+void BasicDoubleQLearningAgent<Table>::learnBatch(
+    const Experience *experiences, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    update(experiences[i]);
+  }
+}
+
+template <typename Table>
+void BasicDoubleQLearningAgent<Table>::update(const Experience &experience) {
+  // One fair coin per update decides which table learns
+  const bool updateA = (rng_() & 1u) != 0;
+  Table &learner = updateA ? tableA_ : tableB_;
+  const Table &critic = updateA ? tableB_ : tableA_;
+
+  double target = experience.reward;
+  if (!experience.done) {
+    ActionMask nextActions = experience.validNextActions.empty()
+                                 ? ActionMask::base()
+                                 : experience.validNextActions;
+    Action best = learner.getMaxAction(experience.nextState, nextActions);
+    target += params_.discountFactor * critic.get(experience.nextState, best);
+  }
+
+  double alpha =
+      params_.stepSize(learner.visit(experience.state, experience.action));
+  double q = learner.get(experience.state, experience.action);
+  learner.set(experience.state, experience.action, q + alpha * (target - q));
+}
+
+template <typename Table>
+typename BasicDoubleQLearningAgent<Table>::QValues
+BasicDoubleQLearningAgent<Table>::getAllQValues(const State &state) const {
+  QValues a = tableA_.getAll(state);
+  const QValues b = tableB_.getAll(state);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = (a[i] + b[i]) / 2.0;
+  }
+  return a;
+}
+
+template <typename Table>
+double BasicDoubleQLearningAgent<Table>::getQValue(const State &state,
+                                                   Action action) const {
+  return (tableA_.get(state, action) + tableB_.get(state, action)) / 2.0;
+}
+
+template <typename Table>
+std::string BasicDoubleQLearningAgent<Table>::getName() const {
+  std::string name = "Double Q-Learning";
+  if (Table::Key::SPEC.trueCount) {
+    name += " (Hi-Lo)";
+  }
+  return name;
+}
+
+template <typename Table>
+void BasicDoubleQLearningAgent<Table>::save(const std::string &filepath) const {
+  tableA_.saveToBinary(filepath + ".qtable");
+  tableB_.saveToBinary(filepath + ".qtable2");
+  tableA_.saveVisitsToBinary(filepath + ".visits");
+  tableB_.saveVisitsToBinary(filepath + ".visits2");
+
+  std::ofstream metaFile(filepath + ".meta");
+  if (!metaFile) {
+    throw std::runtime_error("Cannot open meta file for writing");
+  }
+
+  metaFile << "agent_type: " << getName() << "\n";
+  metaFile << "learning_rate: " << params_.learningRate << "\n";
+  metaFile << "discount_factor: " << params_.discountFactor << "\n";
+  metaFile << "epsilon: " << getEpsilon() << "\n";
+  metaFile << "temperature: " << getTemperature() << "\n";
+  metaFile << "epsilon_min: " << params_.epsilonMin << "\n";
+  metaFile << "epsilon_decay: " << params_.epsilonDecay << "\n";
+  metaFile << "step_count: " << stepCount_ << "\n";
+  metaFile << "state_space_size: " << getStateCount() << "\n";
+
+  std::cout << "Saved Double Q-learning agent to " << filepath << "\n";
+  std::cout << "  States learned: " << getStateCount() << "\n";
+  std::cout << "  Steps taken: " << stepCount_ << "\n";
+  std::cout << "  Current epsilon: " << getEpsilon() << "\n";
+}
+
+template <typename Table>
+void BasicDoubleQLearningAgent<Table>::load(const std::string &filepath) {
+  tableA_.loadFromBinary(filepath + ".qtable");
+  tableB_.loadFromBinary(filepath + ".qtable2");
+  if (std::filesystem::exists(filepath + ".visits")) {
+    tableA_.loadVisitsFromBinary(filepath + ".visits");
+    tableB_.loadVisitsFromBinary(filepath + ".visits2");
+  }
+
+  std::ifstream metaFile(filepath + ".meta");
+  if (!metaFile) {
+    throw std::runtime_error("Cannot open meta file for reading");
+  }
+
+  std::string line;
+  while (std::getline(metaFile, line)) {
+    size_t colonPos = line.find(':');
+    if (colonPos == std::string::npos)
+      continue;
+
+    std::string key = line.substr(0, colonPos);
+    std::string value = line.substr(colonPos + 2);
+
+    if (key == "epsilon") {
+      epsilon_ = std::stod(value);
+    } else if (key == "temperature") {
+      temperature_ = std::stod(value);
+    } else if (key == "step_count") {
+      stepCount_ = std::stoull(value);
+    }
+  }
+
+  std::cout << "Loaded Double Q-learning agent from " << filepath << "\n";
+  std::cout << "  States learned: " << getStateCount() << "\n";
+  std::cout << "  Steps taken: " << stepCount_ << "\n";
+  std::cout << "  Current epsilon: " << getEpsilon() << "\n";
+}
+
+template class BasicDoubleQLearningAgent<PolicyTable>;
+template class BasicDoubleQLearningAgent<CountingPolicyTable>;
+
+} // namespace ai
+} // namespace blackjack
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../game/Random.hpp"
+#include "Agent.hpp"
+#include "Exploration.hpp"
+#include "PolicyTable.hpp"
+#include "QLearningAgent.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace blackjack {
+namespace ai {
+
+/** Double Q-learning (van Hasselt 2010): two tables; each update picks one
+ *  at random, takes the next-state argmax from it and the value of that
+ *  action from the other: Q_A(s,a) ← Q_A + α[R + γ Q_B(s', argmax Q_A(s',·))
+ *  - Q_A]. Selection and evaluation use independent noise, so the max of
+ *  noisy estimates no longer biases the target upward. Explores per
+ *  params.exploration on the mean of the tables and their summed counts;
+ *  getQValue() is that mean. α follows params.stepSchedule of
+ *  the learning table's own visit count. Checkpoints hold table A as
+ *  .qtable (loadable by any agent of the same table) and B as .qtable2.
+ *  Single-threaded. */
+template <typename Table> class BasicDoubleQLearningAgent : public Agent {
+public:
+  using Hyperparameters = QLearningHyperparameters;
+  using QValues = typename Table::QValues;
+
+  explicit BasicDoubleQLearningAgent(const Hyperparameters &params =
+                                         Hyperparameters{});
+
+  BasicDoubleQLearningAgent(const BasicDoubleQLearningAgent &other);
+  BasicDoubleQLearningAgent &
+  operator=(const BasicDoubleQLearningAgent &) = delete;
+
+  Action chooseAction(const State &state, ActionMask validActions,
+                      bool training = true) override;
+  void learn(const Experience &experience) override;
+  /** Table updates only: no epsilon decay, no step count. */
+  void learnBatch(const Experience *experiences, size_t n) override;
+  double getQValue(const State &state, Action action) const override;
+  void save(const std::string &filepath) const override;
+  void load(const std::string &filepath) override;
+  std::string getName() const override;
+  bool usesTrueCount() const override { return Table::Key::SPEC.trueCount; }
+  double getExplorationRate() const override {
+    return params_.exploration.rate(getEpsilon(), getTemperature());
+  }
+  size_t getStateCount() const override {
+    return std::max(tableA_.size(), tableB_.size());
+  }
+  bool countsVisits() const override { return true; }
+  /** Updates to (state, action) across both tables. */
+  double getVisitCount(const State &state, Action action) const override {
+    return static_cast<double>(tableA_.getVisits(state, action)) +
+           tableB_.getVisits(state, action);
+  }
+  void seed(uint32_t seed, uint64_t stream = 0) override {
+    rng_ = Rng(seed, stream);
+  }
+  std::unique_ptr<Agent> snapshot() const override {
+    return std::make_unique<BasicDoubleQLearningAgent>(*this);
+  }
+
+  /** Mean of the two tables' rows. */
+  QValues getAllQValues(const State &state) const;
+  double getEpsilon() const { return epsilon_.load(std::memory_order_relaxed); }
+  double getTemperature() const {
+    return temperature_.load(std::memory_order_relaxed);
+  }
+  const Hyperparameters &getHyperparameters() const { return params_; }
+  /** CSV of table A. */
+  void exportQTable(const std::string &filepath) const {
+    tableA_.exportToCSV(filepath);
+  }
+
+private:
+  Hyperparameters params_;
+  Table tableA_;
+  Table tableB_;
+  std::atomic<double> epsilon_;
+  std::atomic<double> temperature_;
+  Rng rng_;
+  uint64_t stepCount_ = 0;
+
+  Action greedyAction(const State &state, ActionMask validActions) const;
+  void update(const Experience &experience);
+};
+
+using DoubleQLearningAgent = BasicDoubleQLearningAgent<PolicyTable>;
+using CountingDoubleQLearningAgent =
+    BasicDoubleQLearningAgent<CountingPolicyTable>;
+
+extern template class BasicDoubleQLearningAgent<PolicyTable>;
+extern template class BasicDoubleQLearningAgent<CountingPolicyTable>;
+
+} // namespace ai
+} // namespace blackjack
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "QLearningAgent.hpp"
+
+namespace blackjack {
+namespace ai {
+
+/** Expected SARSA: Q-learning with the max in the target replaced by the
+ *  expected next value under the agent's own training policy; for ε-greedy
+ *  that is (1 - ε) Q(s',a*) + ε mean_a' Q(s',a'). The expectation averages
+ *  over the exploration noise that a single max would chase, so noisy
+ *  values in rarely visited rows are not systematically overestimated.
+ *  Same table, checkpoints, exploration strategies and threading as
+ *  BasicQLearningAgent; with ε = 0 the two coincide. */
+template <typename Table>
+class BasicExpectedSarsaAgent : public BasicQLearningAgent<Table> {
+public:
+  using BasicQLearningAgent<Table>::BasicQLearningAgent;
+
+  std::unique_ptr<Agent> snapshot() const override {
+    return std::make_unique<BasicExpectedSarsaAgent>(*this);
+  }
+
+protected:
+  double nextStateValue(const State &nextState,
+                        ActionMask nextActions) const override {
+    const typename Table::QValues values = this->table().getAll(nextState);
+    const ActionValues policy = this->behaviourPolicy(nextState, nextActions);
+    double expected = 0.0;
+    for (Action action : nextActions) {
+      expected += policy[static_cast<size_t>(action)] *
+                  values[static_cast<size_t>(action)];
+    }
+    return expected;
+  }
+
+  std::string algorithmName() const override { return "Expected SARSA"; }
+};
+
+using ExpectedSarsaAgent = BasicExpectedSarsaAgent<PolicyTable>;
+using CountingExpectedSarsaAgent = BasicExpectedSarsaAgent<CountingPolicyTable>;
+
+} // namespace ai
+} // namespace blackjack
@@ -0,0 +1,137 @@
+#include "Exploration.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace blackjack {
+namespace ai {
+
+namespace {
+
+size_t index(Action action) { return static_cast<size_t>(action); }
+
+/** Highest value among validActions; ties go to the lowest action. */
+Action greedy(const ActionValues &values, ActionMask validActions) {
+  Action best = validActions.front();
+  for (Action action : validActions) {
+    if (values[index(action)] > values[index(best)]) {
+      best = action;
+    }
+  }
+  return best;
+}
+
+double stateEpsilon(const ExplorationParams &params,
+                    const ActionVisits &visits, double epsilon,
+                    double epsilonMin) {
+  double stateVisits = 0.0;
+  for (double n : visits) {
+    stateVisits += n;
+  }
+  const double h = params.stateEpsilonHalfLife;
+  return std::max(epsilonMin, epsilon * h / (h + stateVisits));
+}
+
+/** UCB1 choice: an untried action if any, else the best upper bound. */
+Action upperConfidence(const ExplorationParams &params,
+                       const ActionValues &values, const ActionVisits &visits,
+                       ActionMask validActions) {
+  double total = 0.0;
+  for (Action action : validActions) {
+    if (visits[index(action)] == 0.0) {
+      return action;
+    }
+    total += visits[index(action)];
+  }
+  const double logTotal = std::log(total);
+  ActionValues bounds{};
+  for (Action action : validActions) {
+    bounds[index(action)] =
+        values[index(action)] +
+        params.ucbConstant * std::sqrt(logTotal / visits[index(action)]);
+  }
+  return greedy(bounds, validActions);
+}
+
+/** Softmax of values/temperature over validActions, shifted by the max so
+ *  no exponent overflows. */
+ActionValues softmax(const ActionValues &values, ActionMask validActions,
+                     double temperature) {
+  const double top = values[index(greedy(values, validActions))];
+  ActionValues weights{};
+  double sum = 0.0;
+  for (Action action : validActions) {
+    weights[index(action)] =
+        std::exp((values[index(action)] - top) / temperature);
+    sum += weights[index(action)];
+  }
+  for (double &w : weights) {
+    w /= sum;
+  }
+  return weights;
+}
+
+} // anonymous namespace
+
+ActionValues explorationProbabilities(const ExplorationParams &params,
+                                      const ActionValues &values,
+                                      const ActionVisits &visits,
+                                      ActionMask validActions, double epsilon,
+                                      double temperature, double epsilonMin) {
+  ActionValues probabilities{};
+  switch (params.strategy) {
+  case ExplorationStrategy::UCB:
+    probabilities[index(
+        upperConfidence(params, values, visits, validActions))] = 1.0;
+    return probabilities;
+  case ExplorationStrategy::BOLTZMANN:
+    return softmax(values, validActions, temperature);
+  case ExplorationStrategy::STATE_EPSILON:
+    epsilon = stateEpsilon(params, visits, epsilon, epsilonMin);
+    break;
+  case ExplorationStrategy::EPSILON_GREEDY:
+    break;
+  }
+  const double share = epsilon / static_cast<double>(validActions.size());
+  for (Action action : validActions) {
+    probabilities[index(action)] = share;
+  }
+  probabilities[index(greedy(values, validActions))] += 1.0 - epsilon;
+  return probabilities;
+}
+
+Action exploreAction(const ExplorationParams &params,
+                     const ActionValues &values, const ActionVisits &visits,
+                     ActionMask validActions, double epsilon,
+                     double temperature, double epsilonMin, Rng &rng) {
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  switch (params.strategy) {
+  case ExplorationStrategy::UCB:
+    return upperConfidence(params, values, visits, validActions);
+  case ExplorationStrategy::BOLTZMANN: {
+    const ActionValues weights = softmax(values, validActions, temperature);
+    double draw = dist(rng);
+    for (Action action : validActions) {
+      draw -= weights[index(action)];
+      if (draw < 0.0) {
+        return action;
+      }
+    }
+    // Rounding left a sliver past the last weight
+    return validActions.nth(validActions.size() - 1);
+  }
+  case ExplorationStrategy::STATE_EPSILON:
+    epsilon = stateEpsilon(params, visits, epsilon, epsilonMin);
+    break;
+  case ExplorationStrategy::EPSILON_GREEDY:
+    break;
+  }
+  if (dist(rng) < epsilon) {
+    return validActions.nth(
+        boundedRandom(rng, static_cast<uint32_t>(validActions.size())));
+  }
+  return greedy(values, validActions);
+}
+
+} // namespace ai
+} // namespace blackjack
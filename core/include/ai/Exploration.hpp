@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../game/Random.hpp"
+#include "Agent.hpp"
+#include <array>
+#include <cstdint>
+
+namespace blackjack {
+namespace ai {
+
+/** How an agent picks actions while training.
+ *  - EPSILON_GREEDY: a uniform random action with probability ε, where ε
+ *    decays by epsilonDecay on every learn() step.
+ *  - STATE_EPSILON: ε(s) = ε·h / (h + N(s)) over the state's own update
+ *    count N(s), so a state first reached late still explores at full rate
+ *    and a common one settles early; no global decay.
+ *  - UCB: UCB1, argmax Q(s,a) + c·sqrt(ln N(s) / N(s,a)), untried actions
+ *    first; deterministic given the counts.
+ *  - BOLTZMANN: softmax of Q(s,·)/τ, where τ decays by temperatureDecay on
+ *    every learn() step. */
+enum class ExplorationStrategy { EPSILON_GREEDY, STATE_EPSILON, UCB, BOLTZMANN };
+
+struct ExplorationParams {
+  ExplorationStrategy strategy = ExplorationStrategy::EPSILON_GREEDY;
+  double ucbConstant = 1.0;            ///< c of UCB
+  double stateEpsilonHalfLife = 100.0; ///< h of STATE_EPSILON: N(s) that halves ε
+  double temperature = 1.0;            ///< Initial τ of BOLTZMANN
+  double temperatureDecay = 0.99995;
+  double temperatureMin = 0.01;
+
+  bool isValid() const {
+    return ucbConstant >= 0 && stateEpsilonHalfLife > 0 &&
+           temperatureMin > 0 && temperature >= temperatureMin &&
+           temperatureDecay > 0 && temperatureDecay <= 1;
+  }
+
+  /** Which per-learn() schedule the strategy runs; the count-driven ones
+   *  run none. */
+  bool decaysEpsilon() const {
+    return strategy == ExplorationStrategy::EPSILON_GREEDY;
+  }
+  bool decaysTemperature() const {
+    return strategy == ExplorationStrategy::BOLTZMANN;
+  }
+
+  /** The number an agent reports as its exploration rate: τ under
+   *  BOLTZMANN, c under UCB, else ε. */
+  double rate(double epsilon, double temperature) const {
+    switch (strategy) {
+    case ExplorationStrategy::BOLTZMANN:
+      return temperature;
+    case ExplorationStrategy::UCB:
+      return ucbConstant;
+    default:
+      return epsilon;
+    }
+  }
+};
+
+/** Per-action Q-values and update counts of one state, in Action order. */
+using ActionValues = std::array<double, 5>;
+using ActionVisits = std::array<double, 5>;
+
+/** π(a|s) of the training policy; 0 outside validActions. epsilon is the
+ *  current global ε (the cap of STATE_EPSILON), temperature the current τ.
+ *  Greedy ties go to the lowest action, as in PolicyTable. */
+ActionValues explorationProbabilities(const ExplorationParams &params,
+                                      const ActionValues &values,
+                                      const ActionVisits &visits,
+                                      ActionMask validActions, double epsilon,
+                                      double temperature, double epsilonMin);
+
+/** One draw from the training policy; validActions must be non-empty. */
+Action exploreAction(const ExplorationParams &params,
+                     const ActionValues &values, const ActionVisits &visits,
+                     ActionMask validActions, double epsilon,
+                     double temperature, double epsilonMin, Rng &rng);
+
+} // namespace ai
+} // namespace blackjack
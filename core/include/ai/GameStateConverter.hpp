@@ -11,45 +11,68 @@ namespace ai {
 /** Maps game (Hands) to AI State and valid actions; outcome → reward scale. */
 class GameStateConverter {
 public:
-  /** allowSplit/allowDouble: use game.canSplit() and game.canDoubleDown() when
-   *  calling from Trainer/Evaluator so split hands get canSplit=false,
-   *  canDouble=false (no double-after-split). */
+  /** allowSplit/allowDouble: use game.canSplit() and game.canDoubleDown() so
+   *  split hands carry the rules' resplit and double-after-split limits.
+   *  trueCount is the bucket for count-aware agents (see trueCountFor). */
   static State toAIState(const Hand &playerHand, const Hand &dealerHand,
-                          bool allowSplit = true, bool allowDouble = true) {
-    auto playerValue = playerHand.getValue();
-
-    const auto &dealerCards = dealerHand.getCards();
-    if (dealerCards.empty()) {
+                          bool allowSplit = true, bool allowDouble = true,
+                          int trueCount = 0) {
+    if (dealerHand.empty()) {
       throw std::logic_error("Dealer has no cards");
     }
+    return toAIState(playerHand, dealerHand.getCards().front(), allowSplit,
+                     allowDouble, trueCount);
+  }
 
-    int dealerUpCard = dealerCards[0].getValue();
-    if (dealerCards[0].isAce()) {
-      dealerUpCard = 1; // state uses 1 for ace
-    }
+  /** Same, from the dealer's upcard alone (see
+   *  BlackjackGame::getDealerUpCard()). */
+  static State toAIState(const Hand &playerHand, const Card &dealerCard,
+                          bool allowSplit = true, bool allowDouble = true,
+                          int trueCount = 0) {
+    auto playerValue = playerHand.getValue();
+
+    int dealerUpCard = dealerCard.getValue(); // ace is 1, as in State
 
     bool canSplit = allowSplit && playerHand.canSplit();
     bool canDouble = allowDouble && (playerHand.size() == 2);
-    return State(playerValue.total, dealerUpCard, playerValue.isSoft, canSplit,
-                 canDouble);
+    State state(playerValue.total, dealerUpCard, playerValue.isSoft, canSplit,
+                canDouble, trueCount);
+    state.cardCount = static_cast<int>(playerHand.size());
+    return state;
+  }
+
+  /** Same, from an observation (BlackjackGame::observe()/step()); a done
+   *  observation maps to the default (terminal) State. */
+  static State toAIState(const Observation &obs, int trueCount = 0) {
+    if (obs.done) {
+      return State();
+    }
+    State state(obs.playerTotal, obs.dealerUpCard, obs.soft,
+                obs.legalActions.contains(Action::SPLIT),
+                obs.legalActions.contains(Action::DOUBLE), trueCount);
+    state.cardCount = obs.cardCount;
+    return state;
+  }
+
+  /** True-count bucket of the visible cards if agent keys on it, else 0. */
+  static int trueCountFor(const Agent &agent, const BlackjackGame &game) {
+    return agent.usesTrueCount() ? State::bucketTrueCount(game.getTrueCount())
+                                 : 0;
   }
 
-  static std::vector<Action> getValidActions(const Hand &playerHand,
-                                             bool allowSplit = true,
-                                             bool allowDouble = true,
-                                             bool allowSurrender = false) {
-    std::vector<Action> actions;
-    actions.reserve(5);
-    actions.push_back(Action::HIT);
-    actions.push_back(Action::STAND);
+  static ActionMask getValidActions(const Hand &playerHand,
+                                    bool allowSplit = true,
+                                    bool allowDouble = true,
+                                    bool allowSurrender = false) {
+    ActionMask actions = ActionMask::base();
     if (allowDouble && playerHand.size() == 2) {
-      actions.push_back(Action::DOUBLE);
+      actions.insert(Action::DOUBLE);
     }
     if (allowSplit && playerHand.canSplit()) {
-      actions.push_back(Action::SPLIT);
+      actions.insert(Action::SPLIT);
     }
     if (allowSurrender && playerHand.size() == 2) {
-      actions.push_back(Action::SURRENDER);
+      actions.insert(Action::SURRENDER);
     }
     return actions;
   }
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "QValueStorage.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace blackjack {
+namespace ai {
+
+/** Index of the lowest set bit of mask; 0 for an empty mask. */
+inline size_t lowestLane(unsigned mask) {
+  if (mask == 0) return 0;
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_ctz(mask));
+#else
+  size_t lane = 0;
+  while (!(mask & 1u)) {
+    mask >>= 1;
+    ++lane;
+  }
+  return lane;
+#endif
+}
+
+/** Reference argmax over the lanes of an 8-lane row selected by mask (bit i
+ *  = lane i). Ties go to the lowest lane; an empty mask returns 0. */
+template <typename Value>
+size_t maskedArgmaxScalar(const Value *row, uint8_t mask) {
+  size_t best = lowestLane(mask);
+  for (size_t lane = best + 1; lane < 8; ++lane) {
+    if ((mask >> lane) & 1u && row[best] < row[lane]) {
+      best = lane;
+    }
+  }
+  return best;
+}
+
+/** maskedArgmaxScalar over a whole row in registers: invalid lanes are
+ *  replaced by the lowest representable value, the maximum is reduced
+ *  across lanes and the first valid lane equal to it wins. Rows are read
+ *  unaligned, so any 8 contiguous values work. */
+inline size_t maskedArgmax(const double *row, uint8_t mask) {
+#if defined(__AVX2__)
+  const __m256i bitsLo = _mm256_setr_epi64x(1, 2, 4, 8);
+  const __m256i bitsHi = _mm256_setr_epi64x(16, 32, 64, 128);
+  const __m256i m = _mm256_set1_epi64x(mask);
+  const __m256d validLo = _mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(_mm256_and_si256(m, bitsLo), bitsLo));
+  const __m256d validHi = _mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(_mm256_and_si256(m, bitsHi), bitsHi));
+  const __m256d lowest =
+      _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+
+  __m256d lo = _mm256_blendv_pd(lowest, _mm256_loadu_pd(row), validLo);
+  __m256d hi = _mm256_blendv_pd(lowest, _mm256_loadu_pd(row + 4), validHi);
+  __m256d best = _mm256_max_pd(lo, hi);
+  best = _mm256_max_pd(best, _mm256_permute_pd(best, 0x5));
+  best = _mm256_max_pd(best, _mm256_permute2f128_pd(best, best, 0x01));
+
+  unsigned hits =
+      static_cast<unsigned>(
+          _mm256_movemask_pd(_mm256_cmp_pd(lo, best, _CMP_EQ_OQ))) |
+      static_cast<unsigned>(
+          _mm256_movemask_pd(_mm256_cmp_pd(hi, best, _CMP_EQ_OQ)))
+          << 4;
+  hits &= mask;
+  return lowestLane(hits ? hits : mask);
+#else
+  return maskedArgmaxScalar(row, mask);
+#endif
+}
+
+inline size_t maskedArgmax(const float *row, uint8_t mask) {
+#if defined(__AVX2__)
+  const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m256 valid = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+      _mm256_and_si256(_mm256_set1_epi32(mask), bits), bits));
+  const __m256 lowest =
+      _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+
+  __m256 values = _mm256_blendv_ps(lowest, _mm256_loadu_ps(row), valid);
+  __m256 best = _mm256_max_ps(
+      values, _mm256_permute_ps(values, _MM_SHUFFLE(2, 3, 0, 1)));
+  best = _mm256_max_ps(best, _mm256_permute_ps(best, _MM_SHUFFLE(1, 0, 3, 2)));
+  best = _mm256_max_ps(best, _mm256_permute2f128_ps(best, best, 0x01));
+
+  unsigned hits = static_cast<unsigned>(
+      _mm256_movemask_ps(_mm256_cmp_ps(values, best, _CMP_EQ_OQ)));
+  hits &= mask;
+  return lowestLane(hits ? hits : mask);
+#else
+  return maskedArgmaxScalar(row, mask);
+#endif
+}
+
+/** Fixed16 rows are 16 bytes, one SSE2 register. */
+template <int Scale>
+size_t maskedArgmax(const Fixed16<Scale> *row, uint8_t mask) {
+  static_assert(sizeof(Fixed16<Scale>) == sizeof(int16_t),
+                "Fixed16 must be a bare int16");
+#if defined(__SSE2__)
+  const __m128i bits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+  const __m128i valid = _mm_cmpeq_epi16(
+      _mm_and_si128(_mm_set1_epi16(static_cast<short>(mask)), bits), bits);
+  const __m128i lowest =
+      _mm_set1_epi16(std::numeric_limits<int16_t>::min());
+
+  __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row));
+  __m128i values = _mm_or_si128(_mm_and_si128(valid, raw),
+                                _mm_andnot_si128(valid, lowest));
+  __m128i best = _mm_max_epi16(
+      values, _mm_shuffle_epi32(values, _MM_SHUFFLE(1, 0, 3, 2)));
+  best = _mm_max_epi16(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+  best = _mm_max_epi16(best,
+                       _mm_shufflelo_epi16(best, _MM_SHUFFLE(2, 3, 0, 1)));
+  best = _mm_shuffle_epi32(_mm_shufflelo_epi16(best, 0), 0);
+
+  // Narrow the 16-bit compare lanes to bytes so movemask yields one bit each
+  __m128i eq = _mm_cmpeq_epi16(values, best);
+  unsigned hits = static_cast<unsigned>(
+      _mm_movemask_epi8(_mm_packs_epi16(eq, _mm_setzero_si128())));
+  hits &= mask;
+  return lowestLane(hits ? hits : mask);
+#else
+  return maskedArgmaxScalar(row, mask);
+#endif
+}
+
+} // namespace ai
+} // namespace blackjack
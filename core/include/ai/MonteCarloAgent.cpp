@@ -0,0 +1,162 @@
+#include "MonteCarloAgent.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace blackjack {
+namespace ai {
+
+template <typename Table>
+BasicMonteCarloAgent<Table>::BasicMonteCarloAgent(const Hyperparameters &params)
+    : params_(params), qTable_(0.0), epsilon_(params.epsilon),
+      rng_(randomSeed()) {
+  if (!params_.isValid()) {
+    throw std::invalid_argument("Invalid hyperparameters");
+  }
+}
+
+template <typename Table>
+BasicMonteCarloAgent<Table>::BasicMonteCarloAgent(
+    const BasicMonteCarloAgent &other)
+    : params_(other.params_), qTable_(other.qTable_),
+      episode_(other.episode_), epsilon_(other.getEpsilon()), rng_(other.rng_),
+      stepCount_(other.stepCount_) {}
+
+template <typename Table>
+Action BasicMonteCarloAgent<Table>::chooseAction(const State &state,
+                                                 ActionMask validActions,
+                                                 bool training) {
+  if (validActions.empty()) {
+    throw std::invalid_argument("No valid actions provided");
+  }
+
+  if (training &&
+      std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < getEpsilon()) {
+    return validActions.nth(
+        boundedRandom(rng_, static_cast<uint32_t>(validActions.size())));
+  }
+  return qTable_.getMaxAction(state, validActions);
+}
+
+template <typename Table>
+void BasicMonteCarloAgent<Table>::learn(const Experience &experience) {
+  episode_.push_back(experience);
+  if (experience.done) {
+    finishEpisode();
+  }
+
+  epsilon_.store(std::max(getEpsilon() * params_.epsilonDecay,
+                          params_.epsilonMin),
+                 std::memory_order_relaxed);
+  ++stepCount_;
+}
+
+template <typename Table>
+void BasicMonteCarloAgent<Table>::finishEpisode() {
+  // Returns accumulate backwards; a first-visit update waits for the pair's
+  // earliest occurrence (episodes are a handful of steps, so the scan for an
+  // earlier one is cheap)
+  double ret = 0.0;
+  for (size_t t = episode_.size(); t-- > 0;) {
+    const Experience &step = episode_[t];
+    ret = step.reward + params_.discountFactor * ret;
+
+    if (params_.firstVisit &&
+        std::any_of(episode_.begin(), episode_.begin() + t,
+                    [&step](const Experience &earlier) {
+                      return earlier.action == step.action &&
+                             Table::Key::index(earlier.state) ==
+                                 Table::Key::index(step.state);
+                    })) {
+      continue;
+    }
+
+    uint32_t visits = qTable_.visit(step.state, step.action);
+    double alpha =
+        params_.learningRate > 0.0 ? params_.learningRate : 1.0 / visits;
+    double q = qTable_.get(step.state, step.action);
+    qTable_.set(step.state, step.action, q + alpha * (ret - q));
+  }
+  episode_.clear();
+}
+
+template <typename Table>
+double BasicMonteCarloAgent<Table>::getQValue(const State &state,
+                                              Action action) const {
+  return qTable_.get(state, action);
+}
+
+template <typename Table>
+std::string BasicMonteCarloAgent<Table>::getName() const {
+  std::string name = "Monte Carlo";
+  if (Table::Key::SPEC.trueCount) {
+    name += " (Hi-Lo)";
+  }
+  return name;
+}
+
+template <typename Table>
+void BasicMonteCarloAgent<Table>::save(const std::string &filepath) const {
+  qTable_.saveToBinary(filepath + ".qtable");
+  qTable_.saveVisitsToBinary(filepath + ".visits");
+
+  std::ofstream metaFile(filepath + ".meta");
+  if (!metaFile) {
+    throw std::runtime_error("Cannot open meta file for writing");
+  }
+
+  metaFile << "agent_type: " << getName() << "\n";
+  metaFile << "learning_rate: " << params_.learningRate << "\n";
+  metaFile << "discount_factor: " << params_.discountFactor << "\n";
+  metaFile << "first_visit: " << (params_.firstVisit ? 1 : 0) << "\n";
+  metaFile << "epsilon: " << getEpsilon() << "\n";
+  metaFile << "epsilon_min: " << params_.epsilonMin << "\n";
+  metaFile << "epsilon_decay: " << params_.epsilonDecay << "\n";
+  metaFile << "step_count: " << stepCount_ << "\n";
+  metaFile << "state_space_size: " << qTable_.size() << "\n";
+
+  std::cout << "Saved Monte Carlo agent to " << filepath << "\n";
+  std::cout << "  States learned: " << qTable_.size() << "\n";
+  std::cout << "  Steps taken: " << stepCount_ << "\n";
+  std::cout << "  Current epsilon: " << getEpsilon() << "\n";
+}
+
+template <typename Table>
+void BasicMonteCarloAgent<Table>::load(const std::string &filepath) {
+  qTable_.loadFromBinary(filepath + ".qtable");
+  qTable_.loadVisitsFromBinary(filepath + ".visits");
+  episode_.clear();
+
+  std::ifstream metaFile(filepath + ".meta");
+  if (!metaFile) {
+    throw std::runtime_error("Cannot open meta file for reading");
+  }
+
+  std::string line;
+  while (std::getline(metaFile, line)) {
+    size_t colonPos = line.find(':');
+    if (colonPos == std::string::npos)
+      continue;
+
+    std::string key = line.substr(0, colonPos);
+    std::string value = line.substr(colonPos + 2);
+
+    if (key == "epsilon") {
+      epsilon_ = std::stod(value);
+    } else if (key == "step_count") {
+      stepCount_ = std::stoull(value);
+    }
+  }
+
+  std::cout << "Loaded Monte Carlo agent from " << filepath << "\n";
+  std::cout << "  States learned: " << qTable_.size() << "\n";
+  std::cout << "  Steps taken: " << stepCount_ << "\n";
+  std::cout << "  Current epsilon: " << getEpsilon() << "\n";
+}
+
+template class BasicMonteCarloAgent<PolicyTable>;
+template class BasicMonteCarloAgent<CountingPolicyTable>;
+
+} // namespace ai
+} // namespace blackjack
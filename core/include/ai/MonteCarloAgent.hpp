@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../game/Random.hpp"
+#include "Agent.hpp"
+#include "PolicyTable.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace blackjack {
+namespace ai {
+
+struct MonteCarloHyperparameters {
+  /** Step size; 0 = sample average (1 / visits), exact for a fixed policy
+   *  but slow to forget returns of the early, mostly random one */
+  double learningRate = 0.05;
+  double discountFactor = 1.0;
+  double epsilon = 1.0;
+  double epsilonDecay = 0.99995;
+  double epsilonMin = 0.01;
+  /** Update a state-action once per episode (its first visit) rather than
+   *  at every visit */
+  bool firstVisit = true;
+
+  bool isValid() const {
+    return learningRate >= 0 && learningRate <= 1 && discountFactor >= 0 &&
+           discountFactor <= 1 && epsilon >= 0 && epsilon <= 1 &&
+           epsilonDecay > 0 && epsilonDecay <= 1 && epsilonMin >= 0 &&
+           epsilonMin <= epsilon;
+  }
+};
+
+/** On-policy Monte Carlo control: learn() buffers a round's experiences and,
+ *  when the last one (done) arrives, moves each Q(s,a) toward the round's
+ *  actual return G (discounted from the step onward) as an incremental mean:
+ *  Q ← Q + (G - Q) / N(s,a). No bootstrapping, so the terminal reward
+ *  reaches every decision of the round at once instead of propagating back
+ *  one step per visit. ε-greedy with the same decay as Q-learning. Visit
+ *  counts live in the Q table (PolicyTable::visit()) and are saved beside
+ *  it as .visits; the Q file is a plain Table checkpoint. Single-threaded:
+ *  episodes are buffered per agent. */
+template <typename Table> class BasicMonteCarloAgent : public Agent {
+public:
+  using Hyperparameters = MonteCarloHyperparameters;
+  using QValues = typename Table::QValues;
+
+  explicit BasicMonteCarloAgent(const Hyperparameters &params =
+                                    Hyperparameters{});
+
+  BasicMonteCarloAgent(const BasicMonteCarloAgent &other);
+  BasicMonteCarloAgent &operator=(const BasicMonteCarloAgent &) = delete;
+
+  Action chooseAction(const State &state, ActionMask validActions,
+                      bool training = true) override;
+  /** Buffers experience; a done experience ends the episode and updates
+   *  every buffered step. */
+  void learn(const Experience &experience) override;
+  // Returns need whole episodes; a replay sample would splice them
+  bool supportsReplay() const override { return false; }
+  double getQValue(const State &state, Action action) const override;
+  void save(const std::string &filepath) const override;
+  void load(const std::string &filepath) override;
+  std::string getName() const override;
+  bool usesTrueCount() const override { return Table::Key::SPEC.trueCount; }
+  double getExplorationRate() const override { return getEpsilon(); }
+  size_t getStateCount() const override { return qTable_.size(); }
+  void seed(uint32_t seed, uint64_t stream = 0) override {
+    rng_ = Rng(seed, stream);
+  }
+  std::unique_ptr<Agent> snapshot() const override {
+    return std::make_unique<BasicMonteCarloAgent>(*this);
+  }
+
+  QValues getAllQValues(const State &state) const {
+    return qTable_.getAll(state);
+  }
+  bool countsVisits() const override { return true; }
+  /** Updates applied to (state, action) so far. */
+  double getVisitCount(const State &state, Action action) const override {
+    return qTable_.getVisits(state, action);
+  }
+  double getEpsilon() const { return epsilon_.load(std::memory_order_relaxed); }
+  const Hyperparameters &getHyperparameters() const { return params_; }
+  void exportQTable(const std::string &filepath) const {
+    qTable_.exportToCSV(filepath);
+  }
+
+private:
+  Hyperparameters params_;
+  Table qTable_;
+  std::vector<Experience> episode_;
+  std::atomic<double> epsilon_;
+  Rng rng_;
+  uint64_t stepCount_ = 0;
+
+  void finishEpisode();
+};
+
+using MonteCarloAgent = BasicMonteCarloAgent<PolicyTable>;
+using CountingMonteCarloAgent = BasicMonteCarloAgent<CountingPolicyTable>;
+
+extern template class BasicMonteCarloAgent<PolicyTable>;
+extern template class BasicMonteCarloAgent<CountingPolicyTable>;
+
+} // namespace ai
+} // namespace blackjack
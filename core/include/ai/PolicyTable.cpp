@@ -7,104 +7,245 @@
 namespace blackjack {
 namespace ai {
 
-void PolicyTable::saveToBinary(const std::string &filepath) const {
+namespace {
+
+/** BasicLayout tables of doubles keep the original record format. */
+template <typename Layout, typename Value> constexpr bool isLegacyFormat() {
+  return Layout::spec == BasicLayout::spec &&
+         QValueCodec<Value>::TAG == QValueCodec<double>::TAG;
+}
+
+template <typename T> void writeRaw(std::ofstream &file, const T &value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> void readRaw(std::ifstream &file, T &value) {
+  file.read(reinterpret_cast<char *>(&value), sizeof(value));
+}
+
+/** Reads one stored value written with storage tag and decodes it. */
+double readValue(std::ifstream &file, uint32_t tag) {
+  switch (tag & 0xFF) {
+  case 0: {
+    double value;
+    readRaw(file, value);
+    return value;
+  }
+  case 1: {
+    float value;
+    readRaw(file, value);
+    return value;
+  }
+  case 2: {
+    int16_t raw;
+    readRaw(file, raw);
+    return static_cast<double>(raw) / static_cast<double>(tag >> 8);
+  }
+  default:
+    throw std::runtime_error("Unknown Q-value storage tag");
+  }
+}
+
+constexpr uint32_t VISITS_VERSION = 1;
+
+} // anonymous namespace
+
+template <typename LayoutT, typename Value>
+void BasicPolicyTable<LayoutT, Value>::saveToBinary(
+    const std::string &filepath) const {
   std::ofstream file(filepath, std::ios::binary);
   if (!file) {
     throw std::runtime_error("Cannot open file for writing: " + filepath);
   }
 
-  uint32_t version = 1;
+  const bool legacy = isLegacyFormat<Layout, Value>();
+  uint32_t version = legacy ? 1 : 2;
   uint64_t tableSize = visited_.count();
 
-  file.write(reinterpret_cast<const char *>(&version), sizeof(version));
-  file.write(reinterpret_cast<const char *>(&tableSize), sizeof(tableSize));
+  writeRaw(file, version);
+  if (!legacy) {
+    writeRaw(file, Key::SPEC.signature());
+    writeRaw(file, Codec::TAG);
+  }
+  writeRaw(file, tableSize);
 
   for (size_t i = 0; i < TABLE_SIZE; ++i) {
     if (!visited_[i]) continue;
 
-    State state = stateFromHash(i);
-
-    file.write(reinterpret_cast<const char *>(&state.playerTotal),
-               sizeof(state.playerTotal));
-    file.write(reinterpret_cast<const char *>(&state.dealerUpCard),
-               sizeof(state.dealerUpCard));
-    file.write(reinterpret_cast<const char *>(&state.hasUsableAce),
-               sizeof(state.hasUsableAce));
-    file.write(reinterpret_cast<const char *>(&state.canSplit),
-               sizeof(state.canSplit));
-    file.write(reinterpret_cast<const char *>(&state.canDouble),
-               sizeof(state.canDouble));
-
+    if (legacy) {
+      State state = Key::fromIndex(i);
+      writeRaw(file, state.playerTotal);
+      writeRaw(file, state.dealerUpCard);
+      writeRaw(file, state.hasUsableAce);
+      writeRaw(file, state.canSplit);
+      writeRaw(file, state.canDouble);
+    } else {
+      writeRaw(file, static_cast<uint32_t>(i));
+    }
     file.write(reinterpret_cast<const char *>(table_[i].data()),
-               sizeof(double) * NUM_ACTIONS);
+               sizeof(Value) * NUM_ACTIONS);
   }
 
   file.close();
 }
 
-void PolicyTable::loadFromBinary(const std::string &filepath) {
+template <typename LayoutT, typename Value>
+void BasicPolicyTable<LayoutT, Value>::loadFromBinary(
+    const std::string &filepath) {
   std::ifstream file(filepath, std::ios::binary);
   if (!file) {
     throw std::runtime_error("Cannot open file for reading: " + filepath);
   }
 
-  uint32_t version;
-  uint64_t tableSize;
+  uint32_t version = 0;
+  uint64_t tableSize = 0;
+  uint32_t tag = QValueCodec<double>::TAG;
 
-  file.read(reinterpret_cast<char *>(&version), sizeof(version));
-  file.read(reinterpret_cast<char *>(&tableSize), sizeof(tableSize));
-
-  if (version != 1) {
+  readRaw(file, version);
+  if (version == 1) {
+    if (!(Layout::spec == BasicLayout::spec)) {
+      throw std::runtime_error(
+          "Q-table was saved with a different layout: " + filepath);
+    }
+  } else if (version == 2) {
+    uint32_t signature = 0;
+    readRaw(file, signature);
+    readRaw(file, tag);
+    if (signature != Key::SPEC.signature()) {
+      throw std::runtime_error(
+          "Q-table was saved with a different layout: " + filepath);
+    }
+  } else {
     throw std::runtime_error("Unsupported file version");
   }
+  readRaw(file, tableSize);
 
   clear();
 
   for (uint64_t i = 0; i < tableSize; ++i) {
-    State state(0, 0, false, false, false);
-    QValues qvalues;
-
-    file.read(reinterpret_cast<char *>(&state.playerTotal),
-              sizeof(state.playerTotal));
-    file.read(reinterpret_cast<char *>(&state.dealerUpCard),
-              sizeof(state.dealerUpCard));
-    file.read(reinterpret_cast<char *>(&state.hasUsableAce),
-              sizeof(state.hasUsableAce));
-    file.read(reinterpret_cast<char *>(&state.canSplit),
-              sizeof(state.canSplit));
-    file.read(reinterpret_cast<char *>(&state.canDouble),
-              sizeof(state.canDouble));
-
-    file.read(reinterpret_cast<char *>(qvalues.data()),
-              sizeof(double) * NUM_ACTIONS);
-
-    size_t idx = state.hash();
-    table_[idx] = qvalues;
+    size_t idx;
+    if (version == 1) {
+      State state(0, 0, false, false, false);
+      readRaw(file, state.playerTotal);
+      readRaw(file, state.dealerUpCard);
+      readRaw(file, state.hasUsableAce);
+      readRaw(file, state.canSplit);
+      readRaw(file, state.canDouble);
+      idx = Key::index(state);
+    } else {
+      uint32_t stored = 0;
+      readRaw(file, stored);
+      idx = stored;
+    }
+    if (!file || idx >= TABLE_SIZE) {
+      throw std::runtime_error("Corrupt Q-table file: " + filepath);
+    }
+
+    table_[idx].fill(Codec::encode(defaultValue_));
+    visits_[idx].fill(0);
+    for (size_t a = 0; a < NUM_ACTIONS; ++a) {
+      table_[idx][a] = Codec::encode(readValue(file, tag));
+    }
     visited_[idx] = true;
   }
 
   file.close();
 }
 
-void PolicyTable::exportToCSV(const std::string &filepath) const {
+template <typename LayoutT, typename Value>
+void BasicPolicyTable<LayoutT, Value>::saveVisitsToBinary(
+    const std::string &filepath) const {
+  std::ofstream file(filepath, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open file for writing: " + filepath);
+  }
+
+  const Visits none{};
+  uint64_t rows = 0;
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    rows += visited_[i] && visits_[i] != none;
+  }
+
+  writeRaw(file, VISITS_VERSION);
+  writeRaw(file, Key::SPEC.signature());
+  writeRaw(file, rows);
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    if (!visited_[i] || visits_[i] == none) continue;
+    writeRaw(file, static_cast<uint32_t>(i));
+    writeRaw(file, visits_[i]);
+  }
+
+  file.close();
+}
+
+template <typename LayoutT, typename Value>
+void BasicPolicyTable<LayoutT, Value>::loadVisitsFromBinary(
+    const std::string &filepath) {
+  std::ifstream file(filepath, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot open file for reading: " + filepath);
+  }
+
+  uint32_t version = 0;
+  uint32_t signature = 0;
+  uint64_t rows = 0;
+  readRaw(file, version);
+  readRaw(file, signature);
+  readRaw(file, rows);
+  if (version != VISITS_VERSION) {
+    throw std::runtime_error("Unsupported file version");
+  }
+  if (signature != Key::SPEC.signature()) {
+    throw std::runtime_error(
+        "Visit counts were saved with a different layout: " + filepath);
+  }
+
+  for (uint64_t i = 0; i < rows; ++i) {
+    uint32_t idx = 0;
+    Visits counts{};
+    readRaw(file, idx);
+    readRaw(file, counts);
+    if (!file || idx >= TABLE_SIZE) {
+      throw std::runtime_error("Corrupt visit count file: " + filepath);
+    }
+    if (visited_[idx]) {
+      visits_[idx] = counts;
+    }
+  }
+
+  file.close();
+}
+
+template <typename LayoutT, typename Value>
+void BasicPolicyTable<LayoutT, Value>::exportToCSV(
+    const std::string &filepath) const {
   std::ofstream file(filepath);
   if (!file) {
     throw std::runtime_error("Cannot open file for writing: " + filepath);
   }
 
-  file << "player_total,dealer_card,usable_ace,Q_HIT,Q_STAND,Q_DOUBLE,Q_SPLIT,Q_SURRENDER\n";
+  file << "player_total,dealer_card,usable_ace,"
+       << (Key::SPEC.trueCount ? "true_count," : "")
+       << (Key::SPEC.cardCountBits > 0 ? "cards," : "")
+       << "Q_HIT,Q_STAND,Q_DOUBLE,Q_SPLIT,Q_SURRENDER\n";
   file << std::fixed << std::setprecision(6);
 
   for (size_t i = 0; i < TABLE_SIZE; ++i) {
     if (!visited_[i]) continue;
 
-    State state = stateFromHash(i);
+    State state = Key::fromIndex(i);
 
     file << state.playerTotal << "," << state.dealerUpCard << ","
          << (state.hasUsableAce ? "1" : "0") << ",";
+    if (Key::SPEC.trueCount) {
+      file << state.trueCount << ",";
+    }
+    if (Key::SPEC.cardCountBits > 0) {
+      file << state.cardCount << ",";
+    }
 
     for (size_t j = 0; j < NUM_ACTIONS; ++j) {
-      file << table_[i][j];
+      file << Codec::decode(table_[i][j]);
       if (j < NUM_ACTIONS - 1) {
         file << ",";
       }
@@ -116,5 +257,14 @@ void PolicyTable::exportToCSV(const std::string &filepath) const {
   file.close();
 }
 
+template class BasicPolicyTable<BasicLayout>;
+template class BasicPolicyTable<CountLayout>;
+template class BasicPolicyTable<CompositionLayout>;
+template class BasicPolicyTable<HitStandLayout>;
+template class BasicPolicyTable<BasicLayout, float>;
+template class BasicPolicyTable<BasicLayout, Fixed16<>>;
+template class BasicPolicyTable<CountLayout, float>;
+template class BasicPolicyTable<CountLayout, Fixed16<>>;
+
 } // namespace ai
 } // namespace blackjack
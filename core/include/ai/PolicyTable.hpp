@@ -1,84 +1,148 @@
 #pragma once
 
 #include "Agent.hpp"
+#include "MaskedArgmax.hpp"
+#include "QValueStorage.hpp"
 #include "State.hpp"
+#include "StateLayout.hpp"
 #include <array>
 #include <bitset>
-#include <limits>
+#include <cstdint>
+#include <mutex>
 #include <string>
 
 namespace blackjack {
 namespace ai {
 
-/** Flat Q-table (state -> action values); state hash is direct array index.
- *  State::hash() fits in 12 bits → 4096 entries max.
- *  Unvisited states return defaultValue_. */
-class PolicyTable {
+/** Flat Q-table (state -> action values) over the key space of Layout (see
+ *  StateLayout.hpp): StateKey<Layout>::index(state) is the direct array
+ *  index, so each instantiation is sized at compile time to exactly the
+ *  fields it keys on. Value is the per-action storage type (double, float
+ *  or Fixed16<Scale>); reads and writes go through double, so callers never
+ *  see the storage precision. Unvisited states return defaultValue_.
+ *
+ *  Rows are padded to ROW_LANES values and the table is cache-line aligned,
+ *  so a row never straddles a line: 64 bytes for double, 32 for float, 16
+ *  for Fixed16. Beside each row sits a count of the updates recorded for
+ *  each action (visit()), kept out of the rows so they stay one line.
+ *
+ *  Concurrent writers must hold lockRow() for the state they touch: rows are
+ *  striped so that each stripe covers exactly one word of visited_, which
+ *  keeps bitset updates race-free without a global lock. The same lock
+ *  covers the row's visit counts. */
+template <typename LayoutT, typename Value = double> class BasicPolicyTable {
 public:
-  static constexpr size_t TABLE_SIZE = 4096;
+  using Layout = LayoutT;
+  using Key = StateKey<Layout>;
+  static constexpr size_t TABLE_SIZE = Key::TABLE_SIZE;
   static constexpr size_t NUM_ACTIONS = 5;  // HIT, STAND, DOUBLE, SPLIT, SURRENDER
+  static constexpr size_t ROWS_PER_STRIPE = 64;
+  static constexpr size_t NUM_STRIPES = TABLE_SIZE / ROWS_PER_STRIPE;
+  static constexpr size_t ROW_LANES = 8;
+  using Codec = QValueCodec<Value>;
+  using Row = std::array<Value, ROW_LANES>;
   using QValues = std::array<double, NUM_ACTIONS>;
+  using Visits = std::array<uint32_t, NUM_ACTIONS>;
 
-  explicit PolicyTable(double defaultValue = 0.0) : defaultValue_(defaultValue) {
+  static_assert(TABLE_SIZE % ROWS_PER_STRIPE == 0,
+                "Stripes must tile the table exactly");
+
+  explicit BasicPolicyTable(double defaultValue = 0.0)
+      : defaultValue_(defaultValue) {
     for (auto &row : table_) {
-      row.fill(defaultValue_);
+      row.fill(Codec::encode(defaultValue_));
     }
   }
 
+  /** Copies values only; stripe locks are never shared between tables. */
+  BasicPolicyTable(const BasicPolicyTable &other)
+      : table_(other.table_), visits_(other.visits_),
+        visited_(other.visited_), defaultValue_(other.defaultValue_) {}
+
+  BasicPolicyTable &operator=(const BasicPolicyTable &other) {
+    table_ = other.table_;
+    visits_ = other.visits_;
+    visited_ = other.visited_;
+    defaultValue_ = other.defaultValue_;
+    return *this;
+  }
+
+  /** Lock guarding the row (and visited_ word) that holds state. */
+  std::unique_lock<std::mutex> lockRow(const State &state) const {
+    return std::unique_lock<std::mutex>(
+        stripes_[Key::index(state) / ROWS_PER_STRIPE]);
+  }
+
   /** Returns defaultValue_ if state not visited. */
   double get(const State &state, Action action) const {
-    size_t idx = state.hash();
+    size_t idx = Key::index(state);
     if (!visited_[idx]) {
       return defaultValue_;
     }
-    return table_[idx][static_cast<size_t>(action)];
+    return Codec::decode(table_[idx][static_cast<size_t>(action)]);
   }
 
   void set(const State &state, Action action, double value) {
-    size_t idx = state.hash();
-    if (!visited_[idx]) {
-      table_[idx].fill(defaultValue_);
-      visited_[idx] = true;
+    size_t idx = touch(Key::index(state));
+    table_[idx][static_cast<size_t>(action)] = Codec::encode(value);
+  }
+
+  /** Count one update of (state, action); saturates at UINT32_MAX.
+   *  Marks the state visited like set(). @return The new count. */
+  uint32_t visit(const State &state, Action action) {
+    uint32_t &count =
+        visits_[touch(Key::index(state))][static_cast<size_t>(action)];
+    if (count != UINT32_MAX) {
+      ++count;
     }
-    table_[idx][static_cast<size_t>(action)] = value;
+    return count;
+  }
+
+  /** Counts of every action, in getAll() order; zeros if unvisited. */
+  Visits getAllVisits(const State &state) const {
+    size_t idx = Key::index(state);
+    return visited_[idx] ? visits_[idx] : Visits{};
+  }
+
+  /** Updates counted for (state, action); 0 for an unvisited state. */
+  uint32_t getVisits(const State &state, Action action) const {
+    size_t idx = Key::index(state);
+    return visited_[idx] ? visits_[idx][static_cast<size_t>(action)] : 0;
   }
 
   /** Order: HIT, STAND, DOUBLE, SPLIT, SURRENDER. Unvisited state returns all default. */
   QValues getAll(const State &state) const {
-    size_t idx = state.hash();
+    QValues values;
+    size_t idx = Key::index(state);
     if (!visited_[idx]) {
-      QValues values;
       values.fill(defaultValue_);
       return values;
     }
-    return table_[idx];
+    for (size_t i = 0; i < NUM_ACTIONS; ++i) {
+      values[i] = Codec::decode(table_[idx][i]);
+    }
+    return values;
   }
 
-  Action getMaxAction(const State &state,
-                      const std::vector<Action> &validActions) const {
-    double maxQ = std::numeric_limits<double>::lowest();
-    Action bestAction = validActions[0];
-
-    for (Action action : validActions) {
-      double q = get(state, action);
-      if (q > maxQ) {
-        maxQ = q;
-        bestAction = action;
-      }
+  /** Best action among validActions, ranked on the stored row with
+   *  maskedArgmax. Ties go to the lowest action; an unvisited state returns
+   *  the lowest valid one. */
+  Action getMaxAction(const State &state, ActionMask validActions) const {
+    size_t idx = Key::index(state);
+    if (!visited_[idx]) {
+      return validActions.front();
     }
-
-    return bestAction;
+    return static_cast<Action>(
+        maskedArgmax(table_[idx].data(), validActions.bits()));
   }
 
-  double getMaxQ(const State &state,
-                 const std::vector<Action> &validActions) const {
-    double maxQ = std::numeric_limits<double>::lowest();
-
-    for (Action action : validActions) {
-      maxQ = std::max(maxQ, get(state, action));
+  double getMaxQ(const State &state, ActionMask validActions) const {
+    size_t idx = Key::index(state);
+    if (!visited_[idx]) {
+      return defaultValue_;
     }
-
-    return maxQ;
+    return Codec::decode(
+        table_[idx][maskedArgmax(table_[idx].data(), validActions.bits())]);
   }
 
   size_t size() const { return visited_.count(); }
@@ -86,31 +150,72 @@ public:
 
   void clear() {
     visited_.reset();
-    // table_ entries are re-initialized lazily in set() after a clear
+    // table_ and visits_ entries are re-initialized lazily in touch()
   }
 
+  /** Version 1 files hold BasicLayout tables of doubles (one State record
+   *  per row). Version 2 files record the layout signature and storage tag,
+   *  then (row index, values) in the table's own precision; loading converts
+   *  between precisions but never between layouts.
+   *  @throws std::runtime_error on I/O failure or a layout mismatch. */
   void saveToBinary(const std::string &filepath) const;
   void loadFromBinary(const std::string &filepath);
 
+  /** Visit counts live in their own file (layout signature, then row index
+   *  and counts per counted row) so the Q-table format is unchanged. Loading
+   *  applies counts to rows already loaded and ignores the rest.
+   *  @throws std::runtime_error on I/O failure or a layout mismatch. */
+  void saveVisitsToBinary(const std::string &filepath) const;
+  void loadVisitsFromBinary(const std::string &filepath);
+
   /** CSV columns:
-   * player_total,dealer_card,usable_ace,Q_HIT,Q_STAND,Q_DOUBLE,Q_SPLIT,Q_SURRENDER */
+   * player_total,dealer_card,usable_ace[,true_count][,cards],Q_HIT,Q_STAND,Q_DOUBLE,Q_SPLIT,Q_SURRENDER */
   void exportToCSV(const std::string &filepath) const;
 
 private:
-  std::array<QValues, TABLE_SIZE> table_;
+  alignas(64) std::array<Row, TABLE_SIZE> table_;
+  std::array<Visits, TABLE_SIZE> visits_;
   std::bitset<TABLE_SIZE> visited_;
   double defaultValue_;
+  mutable std::array<std::mutex, NUM_STRIPES> stripes_;
 
-  /** Reconstruct State from its hash index (inverse of State::hash()). */
-  static State stateFromHash(size_t h) {
-    State s;
-    s.playerTotal   = static_cast<int>(h & 0x1F);
-    s.dealerUpCard  = static_cast<int>((h >> 5) & 0x0F);
-    s.hasUsableAce  = ((h >> 9) & 1) != 0;
-    s.canSplit      = ((h >> 10) & 1) != 0;
-    s.canDouble     = ((h >> 11) & 1) != 0;
-    return s;
+  /** Reset row idx to defaults and zero counts on its first write since
+   *  construction or clear(). @return idx */
+  size_t touch(size_t idx) {
+    if (!visited_[idx]) {
+      table_[idx].fill(Codec::encode(defaultValue_));
+      visits_[idx].fill(0);
+      visited_[idx] = true;
+    }
+    return idx;
   }
 };
+
+/** 4096-row table over the basic state space (true count ignored). */
+using PolicyTable = BasicPolicyTable<BasicLayout>;
+
+/** Table over the count-augmented state space. */
+using CountingPolicyTable = BasicPolicyTable<CountLayout>;
+
+/** Table keyed additionally on the player's card count. */
+using CompositionPolicyTable = BasicPolicyTable<CompositionLayout>;
+
+/** Reduced-precision basic tables: 32- and 16-byte rows. */
+using FloatPolicyTable = BasicPolicyTable<BasicLayout, float>;
+using Fixed16PolicyTable = BasicPolicyTable<BasicLayout, Fixed16<>>;
+
+/** Reduced-precision count tables. */
+using FloatCountingPolicyTable = BasicPolicyTable<CountLayout, float>;
+using Fixed16CountingPolicyTable = BasicPolicyTable<CountLayout, Fixed16<>>;
+
+extern template class BasicPolicyTable<BasicLayout>;
+extern template class BasicPolicyTable<CountLayout>;
+extern template class BasicPolicyTable<CompositionLayout>;
+extern template class BasicPolicyTable<HitStandLayout>;
+extern template class BasicPolicyTable<BasicLayout, float>;
+extern template class BasicPolicyTable<BasicLayout, Fixed16<>>;
+extern template class BasicPolicyTable<CountLayout, float>;
+extern template class BasicPolicyTable<CountLayout, Fixed16<>>;
+
 } // namespace ai
 } // namespace blackjack
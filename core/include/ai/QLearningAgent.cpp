@@ -1,84 +1,160 @@
 #include "QLearningAgent.hpp"
 #include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
 
 namespace blackjack {
 namespace ai {
-QLearningAgent::QLearningAgent(const Hyperparameters &params)
+template <typename Table>
+BasicQLearningAgent<Table>::BasicQLearningAgent(const Hyperparameters &params)
     : params_(params), qTable_(0.0), epsilon_(params.epsilon),
-      rng_(std::random_device{}()), stepCount_(0) {
+      temperature_(params.exploration.temperature), rng_(randomSeed()),
+      stepCount_(0) {
   if (!params_.isValid()) {
     throw std::invalid_argument("Invalid hyperparameters");
   }
 }
 
-Action QLearningAgent::chooseAction(const State &state,
-                                    const std::vector<Action> &validActions,
-                                    bool training) {
+template <typename Table>
+BasicQLearningAgent<Table>::BasicQLearningAgent(
+    const BasicQLearningAgent &other)
+    : params_(other.params_), qTable_(other.qTable_),
+      epsilon_(other.getEpsilon()), temperature_(other.getTemperature()),
+      rng_(other.rng_),
+      stepCount_(other.stepCount_.load()) {}
+
+template <typename Table>
+Action
+BasicQLearningAgent<Table>::chooseAction(const State &state,
+                                         ActionMask validActions,
+                                         bool training) {
   if (validActions.empty()) {
     throw std::invalid_argument("No valid actions provided");
   }
 
-  if (training) {
-    return epsilonGreedy(state, validActions);
-  } else {
+  if (!training) {
     return greedyAction(state, validActions);
   }
+  if (params_.exploration.strategy == ExplorationStrategy::EPSILON_GREEDY) {
+    return epsilonGreedy(state, validActions);
+  }
+  return explore(state, validActions);
+}
+
+template <typename Table>
+void BasicQLearningAgent<Table>::learn(const Experience &experience) {
+  update(experience);
+  decayExploration();
+  stepCount_.fetch_add(1, std::memory_order_relaxed);
 }
 
-void QLearningAgent::learn(const Experience &experience) {
+template <typename Table>
+void BasicQLearningAgent<Table>::learnBatch(const Experience *experiences,
+                                            size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    update(experiences[i]);
+  }
+}
+
+template <typename Table>
+void BasicQLearningAgent<Table>::update(const Experience &experience) {
   const State &state = experience.state;
   const Action action = experience.action;
   const double reward = experience.reward;
   const State &nextState = experience.nextState;
   const bool done = experience.done;
 
-  double currentQ = qTable_.get(state, action);
   double targetQ;
 
   if (done) {
     targetQ = reward;
   } else {
-    double maxNextQ;
-    if (experience.validNextActions.empty()) {
-      // Terminal or unknown next state: fall back to the two base actions
-      static const std::vector<Action> fallback = {Action::HIT, Action::STAND};
-      maxNextQ = qTable_.getMaxQ(nextState, fallback);
-    } else {
-      maxNextQ = qTable_.getMaxQ(nextState, experience.validNextActions);
+    std::unique_lock<std::mutex> nextLock;
+    if (concurrent_) {
+      nextLock = qTable_.lockRow(nextState);
     }
-    targetQ = reward + params_.discountFactor * maxNextQ;
+    // Terminal or unknown next state: fall back to the two base actions
+    ActionMask nextActions = experience.validNextActions.empty()
+                                 ? ActionMask::base()
+                                 : experience.validNextActions;
+    targetQ = reward + params_.discountFactor *
+                           nextStateValue(nextState, nextActions);
   }
 
-  // Q(s,a) ← Q + α[target - Q]
-  double newQ = currentQ + params_.learningRate * (targetQ - currentQ);
-  qTable_.set(state, action, newQ);
-
-  decayEpsilon();
-  stepCount_++;
+  {
+    std::unique_lock<std::mutex> lock;
+    if (concurrent_) {
+      lock = qTable_.lockRow(state);
+    }
+    // Q(s,a) ← Q + α[target - Q]
+    double alpha = params_.stepSize(qTable_.visit(state, action));
+    double currentQ = qTable_.get(state, action);
+    double newQ = currentQ + alpha * (targetQ - currentQ);
+    qTable_.set(state, action, newQ);
+  }
 }
 
-double QLearningAgent::getQValue(const State &state, Action action) const {
+template <typename Table>
+double BasicQLearningAgent<Table>::getQValue(const State &state,
+                                            Action action) const {
+  std::unique_lock<std::mutex> lock;
+  if (concurrent_) {
+    lock = qTable_.lockRow(state);
+  }
   return qTable_.get(state, action);
 }
 
-void QLearningAgent::save(const std::string &filepath) const {
+template <typename Table>
+double BasicQLearningAgent<Table>::getVisitCount(const State &state,
+                                                Action action) const {
+  std::unique_lock<std::mutex> lock;
+  if (concurrent_) {
+    lock = qTable_.lockRow(state);
+  }
+  return qTable_.getVisits(state, action);
+}
+
+template <typename Table>
+std::string BasicQLearningAgent<Table>::getName() const {
+  std::string name = algorithmName();
+  if (Table::Key::SPEC.trueCount) {
+    name += " (Hi-Lo)";
+  } else if (Table::Key::SPEC.cardCountBits > 0) {
+    name += " (composition)";
+  }
+  switch (Table::Codec::TAG & 0xFF) {
+  case 1:
+    name += " [float]";
+    break;
+  case 2:
+    name += " [fixed16]";
+    break;
+  default:
+    break;
+  }
+  return name;
+}
+
+template <typename Table>
+void BasicQLearningAgent<Table>::save(const std::string &filepath) const {
   std::string qtablePath = filepath + ".qtable";
   std::string metaPath = filepath + ".meta";
 
   qTable_.saveToBinary(qtablePath);
+  qTable_.saveVisitsToBinary(filepath + ".visits");
 
   std::ofstream metaFile(metaPath);
   if (!metaFile) {
     throw std::runtime_error("Cannot open meta file for writing");
   }
 
-  metaFile << "agent_type: Q-Learning\n";
+  metaFile << "agent_type: " << getName() << "\n";
   metaFile << "learning_rate: " << params_.learningRate << "\n";
   metaFile << "discount_factor: " << params_.discountFactor << "\n";
-  metaFile << "epsilon: " << epsilon_ << "\n";
+  metaFile << "epsilon: " << getEpsilon() << "\n";
+  metaFile << "temperature: " << getTemperature() << "\n";
   metaFile << "epsilon_min: " << params_.epsilonMin << "\n";
   metaFile << "epsilon_decay: " << params_.epsilonDecay << "\n";
   metaFile << "step_count: " << stepCount_ << "\n";
@@ -89,14 +165,19 @@ void QLearningAgent::save(const std::string &filepath) const {
   std::cout << "Saved Q-learning agent to " << filepath << "\n";
   std::cout << "  States learned: " << qTable_.size() << "\n";
   std::cout << "  Steps taken: " << stepCount_ << "\n";
-  std::cout << "  Current epsilon: " << epsilon_ << "\n";
+  std::cout << "  Current epsilon: " << getEpsilon() << "\n";
 }
 
-void QLearningAgent::load(const std::string &filepath) {
+template <typename Table>
+void BasicQLearningAgent<Table>::load(const std::string &filepath) {
   std::string qtablePath = filepath + ".qtable";
   std::string metaPath = filepath + ".meta";
 
   qTable_.loadFromBinary(qtablePath);
+  // Checkpoints older than visit counting resume with every count at zero
+  if (std::filesystem::exists(filepath + ".visits")) {
+    qTable_.loadVisitsFromBinary(filepath + ".visits");
+  }
 
   std::ifstream metaFile(metaPath);
   if (!metaFile) {
@@ -115,6 +196,8 @@ void QLearningAgent::load(const std::string &filepath) {
    
     if (key == "epsilon") {
       epsilon_ = std::stod(value);
+    } else if (key == "temperature") {
+      temperature_ = std::stod(value);
     } else if (key == "step_count") {
       stepCount_ = std::stoull(value);
     }
@@ -125,38 +208,107 @@ void QLearningAgent::load(const std::string &filepath) {
   std::cout << "Loaded Q-learning agent from " << filepath << "\n";
   std::cout << "  States learned: " << qTable_.size() << "\n";
   std::cout << "  Steps taken: " << stepCount_ << "\n";
-  std::cout << "  Current epsilon: " << epsilon_ << "\n";
+  std::cout << "  Current epsilon: " << getEpsilon() << "\n";
 }
 
-void QLearningAgent::reset() {
+template <typename Table>
+void BasicQLearningAgent<Table>::reset() {
   qTable_.clear();
   epsilon_ = params_.epsilon;
+  temperature_ = params_.exploration.temperature;
   stepCount_ = 0;
 }
 
-Action QLearningAgent::epsilonGreedy(const State &state,
-                                     const std::vector<Action> &validActions) {
+template <typename Table>
+Rng &BasicQLearningAgent<Table>::explorationRng() {
+  if (!concurrent_) {
+    return rng_;
+  }
+  // Each training worker explores with its own generator, looked up once
+  // per thread and agent; map nodes never move, so the cached pointer holds
+  thread_local uint64_t cachedOwner = 0;
+  thread_local Rng *cached = nullptr;
+  if (cachedOwner != instanceId_) {
+    std::lock_guard<std::mutex> lock(workerRngsMutex_);
+    cached = &workerRngs_.try_emplace(std::this_thread::get_id(), randomSeed())
+                  .first->second;
+    cachedOwner = instanceId_;
+  }
+  return *cached;
+}
+
+template <typename Table>
+uint64_t BasicQLearningAgent<Table>::nextInstanceId() {
+  // One sequence per table type, like the cache it keys; 0 = empty cache
+  static std::atomic<uint64_t> next{1};
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Table>
+Action BasicQLearningAgent<Table>::epsilonGreedy(
+    const State &state, ActionMask validActions) {
+  Rng &rng = explorationRng();
   std::uniform_real_distribution<double> dist(0.0, 1.0);
-  double rand = dist(rng_);
+  double rand = dist(rng);
 
-  if (rand < epsilon_) {
+  if (rand < getEpsilon()) {
     std::uniform_int_distribution<size_t> actionDist(0,
                                                      validActions.size() - 1);
-    return validActions[actionDist(rng_)];
+    return validActions.nth(actionDist(rng));
   } else {
     return greedyAction(state, validActions);
   }
 }
 
-Action
-QLearningAgent::greedyAction(const State &state,
-                             const std::vector<Action> &validActions) const {
+template <typename Table>
+Action BasicQLearningAgent<Table>::greedyAction(
+    const State &state, ActionMask validActions) const {
+  std::unique_lock<std::mutex> lock;
+  if (concurrent_) {
+    lock = qTable_.lockRow(state);
+  }
   return qTable_.getMaxAction(state, validActions);
 }
 
-void QLearningAgent::decayEpsilon() {
-  epsilon_ *= params_.epsilonDecay;
-  epsilon_ = std::max(epsilon_, params_.epsilonMin);
+template <typename Table>
+Action BasicQLearningAgent<Table>::explore(const State &state,
+                                          ActionMask validActions) {
+  ActionValues values;
+  ActionVisits visits;
+  {
+    std::unique_lock<std::mutex> lock;
+    if (concurrent_) {
+      lock = qTable_.lockRow(state);
+    }
+    values = qTable_.getAll(state);
+    visits = visitsOf(state);
+  }
+  return exploreAction(params_.exploration, values, visits, validActions,
+                       getEpsilon(), getTemperature(), params_.epsilonMin,
+                       explorationRng());
 }
+
+template <typename Table>
+void BasicQLearningAgent<Table>::decayExploration() {
+  const ExplorationParams &exploration = params_.exploration;
+  if (exploration.decaysEpsilon()) {
+    double epsilon = getEpsilon() * params_.epsilonDecay;
+    epsilon_.store(std::max(epsilon, params_.epsilonMin),
+                   std::memory_order_relaxed);
+  } else if (exploration.decaysTemperature()) {
+    double temperature = getTemperature() * exploration.temperatureDecay;
+    temperature_.store(std::max(temperature, exploration.temperatureMin),
+                       std::memory_order_relaxed);
+  }
+}
+
+template class BasicQLearningAgent<PolicyTable>;
+template class BasicQLearningAgent<CountingPolicyTable>;
+template class BasicQLearningAgent<CompositionPolicyTable>;
+template class BasicQLearningAgent<FloatPolicyTable>;
+template class BasicQLearningAgent<Fixed16PolicyTable>;
+template class BasicQLearningAgent<FloatCountingPolicyTable>;
+template class BasicQLearningAgent<Fixed16CountingPolicyTable>;
+
 } // namespace ai
 } // namespace blackjack
\ No newline at end of file
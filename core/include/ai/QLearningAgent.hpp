@@ -1,52 +1,119 @@
 #pragma once
 
+#include "../game/Random.hpp"
 #include "Agent.hpp"
+#include "Exploration.hpp"
 #include "PolicyTable.hpp"
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <mutex>
 #include <random>
+#include <thread>
+#include <unordered_map>
 
 namespace blackjack {
 namespace ai {
 
+/** Step size of the N-th update of a state-action: CONSTANT is
+ *  learningRate throughout; HARMONIC is 1/N (the sample average);
+ *  POLYNOMIAL is 1/N^ω with ω in (0.5, 1], which forgets early targets
+ *  faster than 1/N while still converging (Even-Dar & Mansour 2003). */
+enum class StepSchedule { CONSTANT, HARMONIC, POLYNOMIAL };
+
+struct QLearningHyperparameters {
+  double learningRate = 0.1;
+  double discountFactor = 0.95;
+  double epsilon = 1.0;
+  double epsilonDecay = 0.99995;
+  double epsilonMin = 0.01;
+  StepSchedule stepSchedule = StepSchedule::CONSTANT;
+  double stepExponent = 0.8; ///< ω of POLYNOMIAL
+  ExplorationParams exploration;
+
+  bool isValid() const {
+    return learningRate > 0 && learningRate <= 1 && discountFactor >= 0 &&
+           discountFactor <= 1 && epsilon >= 0 && epsilon <= 1 &&
+           epsilonDecay > 0 && epsilonDecay <= 1 && epsilonMin >= 0 &&
+           epsilonMin <= epsilon && stepExponent > 0.5 && stepExponent <= 1 &&
+           exploration.isValid();
+  }
+
+  /** α for the visits-th update of a state-action (visits >= 1). */
+  double stepSize(uint32_t visits) const {
+    switch (stepSchedule) {
+    case StepSchedule::HARMONIC:
+      return 1.0 / visits;
+    case StepSchedule::POLYNOMIAL:
+      return std::pow(static_cast<double>(visits), -stepExponent);
+    case StepSchedule::CONSTANT:
+      break;
+    }
+    return learningRate;
+  }
+};
+
 /** Q-learning agent: Q(s,a) ← Q + α[R + γ max Q(s',a') - Q]; ε-greedy
- * exploration with decay. */
-class QLearningAgent : public Agent {
+ * exploration with decay. Table picks the state space: PolicyTable for the
+ * basic one, CountingPolicyTable to learn per true-count bucket,
+ * CompositionPolicyTable to learn per card count. Every update is counted
+ * in the table, and α follows params.stepSchedule of that count. While
+ * training, actions follow params.exploration (ε-greedy by default). */
+template <typename Table> class BasicQLearningAgent : public Agent {
 public:
-  struct Hyperparameters {
-    double learningRate = 0.1;
-    double discountFactor = 0.95;
-    double epsilon = 1.0;
-    double epsilonDecay = 0.99995;
-    double epsilonMin = 0.01;
-
-    bool isValid() const {
-      return learningRate > 0 && learningRate <= 1 && discountFactor >= 0 &&
-             discountFactor <= 1 && epsilon >= 0 && epsilon <= 1 &&
-             epsilonDecay > 0 && epsilonDecay <= 1 && epsilonMin >= 0 &&
-             epsilonMin <= epsilon;
-    }
-  };
+  using Hyperparameters = QLearningHyperparameters;
+  using QValues = typename Table::QValues;
 
-  explicit QLearningAgent(const Hyperparameters &params = Hyperparameters{
-                              0.1, 0.95, 1.0, 0.99995, 0.01});
+  explicit BasicQLearningAgent(const Hyperparameters &params =
+                                   Hyperparameters{});
+
+  /** Copies Q-table, epsilon and step count; the copy is never concurrent. */
+  BasicQLearningAgent(const BasicQLearningAgent &other);
+  BasicQLearningAgent &operator=(const BasicQLearningAgent &) = delete;
 
   Action chooseAction(const State &state,
-                      const std::vector<Action> &validActions,
+                      ActionMask validActions,
                       bool training = true) override;
   void learn(const Experience &experience) override;
+  /** Q updates only: replayed experiences neither decay epsilon nor count
+   *  as steps. */
+  void learnBatch(const Experience *experiences, size_t n) override;
   double getQValue(const State &state, Action action) const override;
   void save(const std::string &filepath) const override;
   void load(const std::string &filepath) override;
-  std::string getName() const override { return "Q-Learning"; }
-  double getExplorationRate() const override { return epsilon_; }
+  /** "Q-Learning", tagged with the state space and storage precision when
+   *  they differ from the basic double table. */
+  std::string getName() const override;
+  bool usesTrueCount() const override { return Table::Key::SPEC.trueCount; }
+  double getExplorationRate() const override {
+    return params_.exploration.rate(getEpsilon(), getTemperature());
+  }
   size_t getStateCount() const override { return qTable_.size(); }
+  bool countsVisits() const override { return true; }
+  double getVisitCount(const State &state, Action action) const override;
+  void seed(uint32_t seed, uint64_t stream = 0) override {
+    explorationRng() = Rng(seed, stream);
+  }
+  /** Row-locked table access and per-thread exploration RNG. Epsilon decay
+   *  stays approximate under contention (a racing decay may be dropped). */
+  bool enableConcurrentLearning() override {
+    concurrent_ = true;
+    return true;
+  }
+  std::unique_ptr<Agent> snapshot() const override {
+    return std::make_unique<BasicQLearningAgent>(*this);
+  }
 
-  PolicyTable::QValues getAllQValues(const State &state) const {
+  QValues getAllQValues(const State &state) const {
     return qTable_.getAll(state);
   }
-  double getEpsilon() const { return epsilon_; }
+  double getEpsilon() const { return epsilon_.load(std::memory_order_relaxed); }
+  double getTemperature() const {
+    return temperature_.load(std::memory_order_relaxed);
+  }
   void setEpsilon(double epsilon) {
-    epsilon_ = std::max(params_.epsilonMin, std::min(1.0, epsilon));
+    epsilon_.store(std::max(params_.epsilonMin, std::min(1.0, epsilon)),
+                   std::memory_order_relaxed);
   }
   size_t getStateSpaceSize() const { return qTable_.size(); }
   const Hyperparameters &getHyperparameters() const { return params_; }
@@ -55,18 +122,73 @@ public:
   }
   void reset();
 
+protected:
+  /** The bootstrap term max_a' Q(s',a') over nextActions; variants swap in
+   *  their own estimate. Called with s' row-locked when concurrent. */
+  virtual double nextStateValue(const State &nextState,
+                                ActionMask nextActions) const {
+    return qTable_.getMaxQ(nextState, nextActions);
+  }
+  /** π(·|state) of the training policy over validActions. Caller holds
+   *  the row lock when concurrent. */
+  ActionValues behaviourPolicy(const State &state,
+                               ActionMask validActions) const {
+    return explorationProbabilities(
+        params_.exploration, qTable_.getAll(state), visitsOf(state),
+        validActions, getEpsilon(), getTemperature(), params_.epsilonMin);
+  }
+  /** Leading word of getName(). */
+  virtual std::string algorithmName() const { return "Q-Learning"; }
+  const Table &table() const { return qTable_; }
+
 private:
   Hyperparameters params_;
-  PolicyTable qTable_;
-  double epsilon_;
-  mutable std::mt19937 rng_;
-  uint64_t stepCount_;
+  Table qTable_;
+  std::atomic<double> epsilon_;
+  std::atomic<double> temperature_;
+  Rng rng_;
+  std::atomic<uint64_t> stepCount_;
+  bool concurrent_ = false;
+  /** Under concurrent learning, each thread's exploration generator, owned
+   *  by this agent so seed() never reaches another agent's draws. */
+  std::unordered_map<std::thread::id, Rng> workerRngs_;
+  std::mutex workerRngsMutex_;
+  /** Distinct per agent (copies included); keys the per-thread cache. */
+  const uint64_t instanceId_ = nextInstanceId();
+
+  static uint64_t nextInstanceId();
+  Rng &explorationRng();
 
   Action epsilonGreedy(const State &state,
-                       const std::vector<Action> &validActions);
+                       ActionMask validActions);
+  /** A training action for any strategy other than EPSILON_GREEDY. */
+  Action explore(const State &state, ActionMask validActions);
+  ActionVisits visitsOf(const State &state) const {
+    const typename Table::Visits counts = qTable_.getAllVisits(state);
+    ActionVisits visits;
+    std::copy(counts.begin(), counts.end(), visits.begin());
+    return visits;
+  }
   Action greedyAction(const State &state,
-                      const std::vector<Action> &validActions) const;
-  void decayEpsilon();
+                      ActionMask validActions) const;
+  /** Step the strategy's per-learn() schedule, if it has one. */
+  void decayExploration();
+  /** One Q-learning update, nothing else. */
+  void update(const Experience &experience);
 };
+
+using QLearningAgent = BasicQLearningAgent<PolicyTable>;
+using CountingQLearningAgent = BasicQLearningAgent<CountingPolicyTable>;
+using CompositionQLearningAgent = BasicQLearningAgent<CompositionPolicyTable>;
+using FloatQLearningAgent = BasicQLearningAgent<FloatPolicyTable>;
+using Fixed16QLearningAgent = BasicQLearningAgent<Fixed16PolicyTable>;
+
+extern template class BasicQLearningAgent<PolicyTable>;
+extern template class BasicQLearningAgent<CountingPolicyTable>;
+extern template class BasicQLearningAgent<CompositionPolicyTable>;
+extern template class BasicQLearningAgent<FloatPolicyTable>;
+extern template class BasicQLearningAgent<Fixed16PolicyTable>;
+extern template class BasicQLearningAgent<FloatCountingPolicyTable>;
+extern template class BasicQLearningAgent<Fixed16CountingPolicyTable>;
 } // namespace ai
 } // namespace blackjack
\ No newline at end of file
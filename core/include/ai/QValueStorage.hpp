@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace blackjack {
+namespace ai {
+
+/** Q-value stored as a 16-bit fixed-point number: value = raw / Scale.
+ *  The default scale covers ±8 (every reachable return, splits and doubles
+ *  included) at a resolution of ~0.00024. Out-of-range writes saturate. */
+template <int Scale = 4096> struct Fixed16 {
+  static_assert(Scale > 0 && Scale <= 32767, "Scale must fit in int16");
+  static constexpr int SCALE = Scale;
+  int16_t raw = 0;
+
+  constexpr bool operator<(const Fixed16 &other) const {
+    return raw < other.raw;
+  }
+};
+
+/** Converts between the table's storage type and the double-valued API.
+ *  Encoding is monotonic, so comparisons on stored values rank actions the
+ *  same way as the decoded doubles. */
+template <typename Value> struct QValueCodec {
+  static_assert(std::is_same<Value, double>::value ||
+                    std::is_same<Value, float>::value,
+                "Q-values are stored as float, double or Fixed16<Scale>");
+
+  /** Tag written into saved tables (see PolicyTable::saveToBinary). */
+  static constexpr uint32_t TAG = std::is_same<Value, double>::value ? 0 : 1;
+
+  static Value encode(double value) { return static_cast<Value>(value); }
+  static double decode(Value value) { return static_cast<double>(value); }
+};
+
+template <int Scale> struct QValueCodec<Fixed16<Scale>> {
+  static constexpr uint32_t TAG = 2u | (static_cast<uint32_t>(Scale) << 8);
+
+  static Fixed16<Scale> encode(double value) {
+    double scaled = std::round(value * Scale);
+    scaled = std::max(-32767.0, std::min(32767.0, scaled));
+    Fixed16<Scale> fixed;
+    fixed.raw = static_cast<int16_t>(scaled);
+    return fixed;
+  }
+  static double decode(Fixed16<Scale> value) {
+    return static_cast<double>(value.raw) / Scale;
+  }
+};
+
+} // namespace ai
+} // namespace blackjack
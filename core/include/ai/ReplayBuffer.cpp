@@ -0,0 +1,101 @@
+#include "ReplayBuffer.hpp"
+#include <stdexcept>
+
+namespace blackjack {
+namespace ai {
+
+namespace {
+
+/** Uniform double in [0, 1) from 53 random bits. */
+double uniformUnit(Rng &rng) {
+  uint64_t bits = (uint64_t{rng()} << 21) ^ (rng() >> 11);
+  return static_cast<double>(bits) * 0x1.0p-53;
+}
+
+} // anonymous namespace
+
+ReplayBuffer::ReplayBuffer(size_t capacity) : ring_(capacity), leaves_(1) {
+  if (capacity == 0) {
+    throw std::invalid_argument("Replay buffer capacity must be at least 1");
+  }
+  while (leaves_ < capacity) {
+    leaves_ *= 2;
+  }
+  tree_.assign(2 * leaves_, 0.0);
+}
+
+size_t ReplayBuffer::add(const Experience &experience, double priority) {
+  size_t slot = next_;
+  ring_[slot] = PackedExperience(experience);
+  setPriority(slot, priority);
+  next_ = (next_ + 1) % ring_.size();
+  if (size_ < ring_.size()) {
+    ++size_;
+  }
+  return slot;
+}
+
+void ReplayBuffer::setPriority(size_t slot, double priority) {
+  if (!(priority >= 0.0)) {
+    throw std::invalid_argument("Replay priority must be non-negative");
+  }
+  // Parents are recomputed from their children, so sums never drift
+  size_t node = leaves_ + slot;
+  tree_[node] = priority;
+  for (node /= 2; node >= 1; node /= 2) {
+    tree_[node] = tree_[2 * node] + tree_[2 * node + 1];
+  }
+}
+
+size_t ReplayBuffer::findSlot(double mass) const {
+  size_t node = 1;
+  while (node < leaves_) {
+    size_t left = 2 * node;
+    if (mass < tree_[left] || tree_[left + 1] == 0.0) {
+      node = left;
+    } else {
+      mass -= tree_[left];
+      node = left + 1;
+    }
+  }
+  return node - leaves_;
+}
+
+void ReplayBuffer::sampleUniform(Rng &rng, size_t n,
+                                 std::vector<Experience> &out) const {
+  out.clear();
+  if (size_ == 0) {
+    return;
+  }
+  out.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t slot = boundedRandom(rng, static_cast<uint32_t>(size_));
+    out.push_back(ring_[slot].unpack());
+  }
+}
+
+void ReplayBuffer::samplePrioritized(Rng &rng, size_t n,
+                                     std::vector<Experience> &out,
+                                     std::vector<size_t> *slots) const {
+  out.clear();
+  if (slots) {
+    slots->clear();
+  }
+  if (size_ == 0) {
+    return;
+  }
+  const double total = totalPriority();
+  out.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t slot = total > 0.0
+                      ? findSlot(uniformUnit(rng) * total)
+                      : boundedRandom(rng, static_cast<uint32_t>(size_));
+    out.push_back(ring_[slot].unpack());
+    if (slots) {
+      slots->push_back(slot);
+    }
+  }
+}
+
+} // namespace ai
+} // namespace blackjack
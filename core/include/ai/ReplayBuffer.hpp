@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../game/Random.hpp"
+#include "Agent.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace blackjack {
+namespace ai {
+
+/** An Experience in 16 bytes: states as State::pack(), reward as float
+ *  (every blackjack reward is a multiple of 0.5, so exact). */
+struct PackedExperience {
+  uint32_t state = 0;
+  uint32_t nextState = 0;
+  float reward = 0.0f;
+  Action action = Action::HIT;
+  ActionMask validNextActions;
+  bool done = false;
+
+  PackedExperience() = default;
+  explicit PackedExperience(const Experience &experience)
+      : state(experience.state.pack()),
+        nextState(experience.nextState.pack()),
+        reward(static_cast<float>(experience.reward)),
+        action(experience.action),
+        validNextActions(experience.validNextActions),
+        done(experience.done) {}
+
+  Experience unpack() const {
+    return Experience(State::unpack(state), action, reward,
+                      State::unpack(nextState), done, validNextActions);
+  }
+};
+static_assert(sizeof(PackedExperience) == 16, "PackedExperience grew");
+static_assert(std::is_trivially_copyable<PackedExperience>::value,
+              "PackedExperience must stay POD");
+
+/**
+ * @brief Fixed-capacity ring of experiences for replay
+ *
+ * Allocates everything up front; add() overwrites the oldest entry once
+ * full. Each entry carries a priority, kept in a sum tree so that
+ * samplePrioritized() draws entry i with probability priority_i / total in
+ * O(log capacity), and setPriority() updates one in O(log capacity).
+ * sampleUniform() ignores priorities.
+ */
+class ReplayBuffer {
+public:
+  /** @throws std::invalid_argument if capacity is 0 */
+  explicit ReplayBuffer(size_t capacity);
+
+  /** Stores experience (evicting the oldest when full) with priority >= 0.
+   *  @return its slot, for setPriority() */
+  size_t add(const Experience &experience, double priority = 1.0);
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return ring_.size(); }
+  bool empty() const { return size_ == 0; }
+
+  const PackedExperience &operator[](size_t slot) const { return ring_[slot]; }
+
+  /** @throws std::invalid_argument if priority is negative */
+  void setPriority(size_t slot, double priority);
+  double getPriority(size_t slot) const { return tree_[leaves_ + slot]; }
+  double totalPriority() const { return tree_[1]; }
+
+  /** n draws with replacement, each slot equally likely; replaces out's
+   *  contents. Empty buffer: out is cleared. */
+  void sampleUniform(Rng &rng, size_t n, std::vector<Experience> &out) const;
+
+  /** n draws with replacement in proportion to priority; replaces out's
+   *  contents and, if given, slots (for setPriority()). Falls back to
+   *  uniform when every priority is 0. */
+  void samplePrioritized(Rng &rng, size_t n, std::vector<Experience> &out,
+                         std::vector<size_t> *slots = nullptr) const;
+
+private:
+  std::vector<PackedExperience> ring_;
+  size_t next_ = 0;
+  size_t size_ = 0;
+  /** Sum tree: node k sums nodes 2k and 2k+1; slot i's leaf is
+   *  leaves_ + i, the root is node 1. */
+  size_t leaves_;
+  std::vector<double> tree_;
+
+  size_t findSlot(double mass) const;
+};
+
+} // namespace ai
+} // namespace blackjack
@@ -22,6 +22,14 @@ std::string State::toString() const {
     oss << ", canDouble";
   }
 
+  if (trueCount != 0) {
+    oss << ", tc=" << (trueCount > 0 ? "+" : "") << trueCount;
+  }
+
+  if (cardCount != 0) {
+    oss << ", cards=" << cardCount;
+  }
+
   oss << ")";
   return oss.str();
 }
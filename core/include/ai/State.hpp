@@ -1,18 +1,28 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <string>
 
 namespace blackjack {
 namespace ai {
 
-/** Discrete RL state: player total (4-21), dealer upcard (1-10, Ace=1), soft hand. */
+/** Discrete RL state: player total (4-21), dealer upcard (1-10, Ace=1), soft
+ *  hand, plus an optional Hi-Lo true-count bucket and card count for tables
+ *  whose StateLayout keys on them. */
 struct State {
+  static constexpr int MIN_TRUE_COUNT = -5;
+  static constexpr int MAX_TRUE_COUNT = 5;
+  static constexpr size_t NUM_TRUE_COUNTS = MAX_TRUE_COUNT - MIN_TRUE_COUNT + 1;
+
   int playerTotal;
   int dealerUpCard;
   bool hasUsableAce;
   bool canSplit = false;   // optional; not in basic Q-learning
   bool canDouble = false;
+  int trueCount = 0;       // bucket in [MIN_TRUE_COUNT, MAX_TRUE_COUNT]
+  int cardCount = 0;       // cards in the player's hand; 0 = not tracked
 
   // Default constructor for terminal/uninitialized states
   State() : playerTotal(0), dealerUpCard(0), hasUsableAce(false) {}
@@ -22,9 +32,16 @@ struct State {
         hasUsableAce(hasUsableAce) {}
 
   State(int playerTotal, int dealerUpCard, bool hasUsableAce, bool canSplit,
-        bool canDouble)
+        bool canDouble, int trueCount = 0)
       : playerTotal(playerTotal), dealerUpCard(dealerUpCard),
-        hasUsableAce(hasUsableAce), canSplit(canSplit), canDouble(canDouble) {}
+        hasUsableAce(hasUsableAce), canSplit(canSplit), canDouble(canDouble),
+        trueCount(trueCount) {}
+
+  /** Truncates toward zero and clamps to [MIN_TRUE_COUNT, MAX_TRUE_COUNT]. */
+  static int bucketTrueCount(double trueCount) {
+    int bucket = static_cast<int>(trueCount);
+    return std::max(MIN_TRUE_COUNT, std::min(MAX_TRUE_COUNT, bucket));
+  }
 
   /** Bit-packed for Q-table key: total(5) | upcard(4) | ace(1) | split(1) | double(1). */
   size_t hash() const {
@@ -37,18 +54,55 @@ struct State {
     return h;
   }
 
+  /** hash() with the true-count bucket above it: 12 bits | bucket(4) →
+   *  dense in [0, 4096 * NUM_TRUE_COUNTS). */
+  size_t countedHash() const {
+    return hash() | (static_cast<size_t>(trueCount - MIN_TRUE_COUNT) << 12);
+  }
+
+  /** Every field in 21 bits: total(5) | upcard(4) | ace | split | double |
+   *  count bucket(4) | cardCount(5) | spare. unpack(pack()) is lossless for
+   *  valid and default states; storage format, not a table key. */
+  uint32_t pack() const {
+    return (static_cast<uint32_t>(playerTotal) & 0x1F) |
+           (static_cast<uint32_t>(dealerUpCard) & 0x0F) << 5 |
+           static_cast<uint32_t>(hasUsableAce) << 9 |
+           static_cast<uint32_t>(canSplit) << 10 |
+           static_cast<uint32_t>(canDouble) << 11 |
+           (static_cast<uint32_t>(trueCount - MIN_TRUE_COUNT) & 0x0F) << 12 |
+           (static_cast<uint32_t>(cardCount) & 0x1F) << 16;
+  }
+
+  static State unpack(uint32_t bits) {
+    State state(static_cast<int>(bits & 0x1F),
+                static_cast<int>(bits >> 5 & 0x0F), (bits >> 9 & 1) != 0,
+                (bits >> 10 & 1) != 0, (bits >> 11 & 1) != 0,
+                static_cast<int>(bits >> 12 & 0x0F) + MIN_TRUE_COUNT);
+    state.cardCount = static_cast<int>(bits >> 16 & 0x1F);
+    return state;
+  }
+
   bool operator==(const State &other) const {
     return playerTotal == other.playerTotal &&
            dealerUpCard == other.dealerUpCard &&
            hasUsableAce == other.hasUsableAce && canSplit == other.canSplit &&
-           canDouble == other.canDouble;
+           canDouble == other.canDouble && trueCount == other.trueCount &&
+           cardCount == other.cardCount;
   }
 
   bool operator!=(const State &other) const { return !(*this == other); }
 
+  /** A pair of aces that may not double: a split ace offered a resplit.
+   *  Split aces take no more cards, so STAND and SPLIT are its only
+   *  actions (an unsplit two-card hand can always double). */
+  bool isSplitAces() const {
+    return canSplit && !canDouble && hasUsableAce && playerTotal == 12;
+  }
+
   bool isValid() const {
     return playerTotal >= 4 && playerTotal <= 21 && dealerUpCard >= 1 &&
-           dealerUpCard <= 10;
+           dealerUpCard <= 10 && trueCount >= MIN_TRUE_COUNT &&
+           trueCount <= MAX_TRUE_COUNT;
   }
 
   std::string toString() const;
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "State.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace blackjack {
+namespace ai {
+
+/** Which State fields key a table row, and how wide each is. Player total
+ *  (5 bits) and dealer upcard (4 bits) are always present; the remaining
+ *  fields pack above them in declaration order when enabled. */
+struct StateLayoutSpec {
+  bool soft;
+  bool canSplit;
+  bool canDouble;
+  bool trueCount;         ///< 4 bits: bucket - State::MIN_TRUE_COUNT
+  unsigned cardCountBits; ///< cards in hand 2 .. 2 + 2^bits - 1 (last = "or more")
+
+  constexpr unsigned bits() const {
+    return 5 + 4 + (soft ? 1 : 0) + (canSplit ? 1 : 0) + (canDouble ? 1 : 0) +
+           (trueCount ? 4 : 0) + cardCountBits;
+  }
+
+  constexpr bool operator==(const StateLayoutSpec &other) const {
+    return soft == other.soft && canSplit == other.canSplit &&
+           canDouble == other.canDouble && trueCount == other.trueCount &&
+           cardCountBits == other.cardCountBits;
+  }
+
+  /** Stable tag written into saved tables. */
+  constexpr uint32_t signature() const {
+    return (soft ? 1u : 0u) | (canSplit ? 2u : 0u) | (canDouble ? 4u : 0u) |
+           (trueCount ? 8u : 0u) | (cardCountBits << 4);
+  }
+};
+
+/** Layout descriptors: each names a constexpr StateLayoutSpec. */
+
+/** Same packing as State::hash(): 12 bits, 4096 rows. */
+struct BasicLayout {
+  static constexpr StateLayoutSpec spec{true, true, true, false, 0};
+};
+
+/** Same packing as State::countedHash(): 16 bits, one basic block per
+ *  true-count bucket. */
+struct CountLayout {
+  static constexpr StateLayoutSpec spec{true, true, true, true, 0};
+};
+
+/** Basic layout plus the player's card count (2, 3, 4, 5+) for
+ *  composition-dependent plays such as standing on a multi-card 16. */
+struct CompositionLayout {
+  static constexpr StateLayoutSpec spec{true, true, true, false, 2};
+};
+
+/** Smallest useful key (total, upcard, soft): 1024 rows, for agents that
+ *  only choose between HIT and STAND. */
+struct HitStandLayout {
+  static constexpr StateLayoutSpec spec{true, false, false, false, 0};
+};
+
+/** Packs/unpacks State into a dense row index for Layout, all at compile
+ *  time: each enabled field is a shift and a mask. */
+template <typename Layout> struct StateKey {
+  static constexpr StateLayoutSpec SPEC = Layout::spec;
+  static constexpr size_t BITS = SPEC.bits();
+  static constexpr size_t TABLE_SIZE = size_t{1} << BITS;
+
+  static constexpr unsigned SOFT_SHIFT = 9;
+  static constexpr unsigned SPLIT_SHIFT = SOFT_SHIFT + (SPEC.soft ? 1 : 0);
+  static constexpr unsigned DOUBLE_SHIFT = SPLIT_SHIFT + (SPEC.canSplit ? 1 : 0);
+  static constexpr unsigned COUNT_SHIFT =
+      DOUBLE_SHIFT + (SPEC.canDouble ? 1 : 0);
+  static constexpr unsigned CARDS_SHIFT = COUNT_SHIFT + (SPEC.trueCount ? 4 : 0);
+  static constexpr int MAX_CARD_BUCKET = (1 << SPEC.cardCountBits) - 1;
+
+  static_assert(BITS <= 20, "State layout too large for a dense table");
+
+  static size_t index(const State &s) {
+    size_t h = (static_cast<size_t>(s.playerTotal) & 0x1F) |
+               ((static_cast<size_t>(s.dealerUpCard) & 0x0F) << 5);
+    if (SPEC.soft) {
+      h |= (s.hasUsableAce ? size_t{1} : 0) << SOFT_SHIFT;
+    }
+    if (SPEC.canSplit) {
+      h |= (s.canSplit ? size_t{1} : 0) << SPLIT_SHIFT;
+    }
+    if (SPEC.canDouble) {
+      h |= (s.canDouble ? size_t{1} : 0) << DOUBLE_SHIFT;
+    }
+    if (SPEC.trueCount) {
+      h |= (static_cast<size_t>(s.trueCount - State::MIN_TRUE_COUNT) & 0x0F)
+           << COUNT_SHIFT;
+    }
+    if (SPEC.cardCountBits > 0) {
+      int bucket = std::max(0, std::min(MAX_CARD_BUCKET, s.cardCount - 2));
+      h |= static_cast<size_t>(bucket) << CARDS_SHIFT;
+    }
+    return h;
+  }
+
+  /** Inverse of index() for the fields the layout keeps; others default. */
+  static State fromIndex(size_t h) {
+    State s;
+    s.playerTotal = static_cast<int>(h & 0x1F);
+    s.dealerUpCard = static_cast<int>((h >> 5) & 0x0F);
+    if (SPEC.soft) {
+      s.hasUsableAce = ((h >> SOFT_SHIFT) & 1) != 0;
+    }
+    if (SPEC.canSplit) {
+      s.canSplit = ((h >> SPLIT_SHIFT) & 1) != 0;
+    }
+    if (SPEC.canDouble) {
+      s.canDouble = ((h >> DOUBLE_SHIFT) & 1) != 0;
+    }
+    if (SPEC.trueCount) {
+      s.trueCount =
+          static_cast<int>((h >> COUNT_SHIFT) & 0x0F) + State::MIN_TRUE_COUNT;
+    }
+    if (SPEC.cardCountBits > 0) {
+      s.cardCount = static_cast<int>((h >> CARDS_SHIFT) & MAX_CARD_BUCKET) + 2;
+    }
+    return s;
+  }
+};
+
+} // namespace ai
+} // namespace blackjack
@@ -0,0 +1,76 @@
+#include "VectorEnv.hpp"
+#include "GameStateConverter.hpp"
+#include <stdexcept>
+
+namespace blackjack {
+namespace ai {
+
+VectorEnv::VectorEnv(const GameRules &rules, size_t numEnvs,
+                     std::optional<uint32_t> seed, uint64_t firstStream,
+                     bool trueCount, ShuffleMode mode)
+    : trueCount_(trueCount), states_(numEnvs), masks_(numEnvs),
+      rewards_(numEnvs), dones_(numEnvs) {
+  if (numEnvs == 0) {
+    throw std::invalid_argument("VectorEnv needs at least one game");
+  }
+  // Games of one run share its seed; unseeded, each draws its own
+  const uint32_t shoeSeed = seed ? *seed : randomSeed();
+  games_.reserve(numEnvs);
+  for (size_t i = 0; i < numEnvs; ++i) {
+    games_.emplace_back(rules, shoeSeed, firstStream + i, mode);
+    deal(i);
+  }
+}
+
+void VectorEnv::step(const std::vector<Action> &actions) {
+  if (actions.size() != games_.size()) {
+    throw std::invalid_argument("VectorEnv::step needs one action per game");
+  }
+  for (size_t i = 0; i < games_.size(); ++i) {
+    Observation obs = games_[i].step(actions[i]);
+    dones_[i] = obs.done;
+    if (obs.done) {
+      rewards_[i] = settle(i);
+      deal(i);
+    } else {
+      rewards_[i] = 0.0;
+      observe(i, obs);
+    }
+  }
+}
+
+double VectorEnv::settle(size_t i) {
+  const std::vector<Outcome> &outcomes = games_[i].getOutcomes();
+  const std::vector<bool> &doubled = games_[i].getWasDoubledByHand();
+  double reward = 0.0;
+  for (size_t h = 0; h < outcomes.size(); ++h) {
+    reward += GameStateConverter::outcomeToReward(
+        outcomes[h], h < doubled.size() && doubled[h]);
+  }
+  ++roundsPlayed_;
+  totalReward_ += reward;
+  return reward;
+}
+
+void VectorEnv::deal(size_t i) {
+  while (true) {
+    games_[i].startRound();
+    Observation obs = games_[i].observe();
+    if (!obs.done) {
+      observe(i, obs);
+      return;
+    }
+    settle(i);
+  }
+}
+
+void VectorEnv::observe(size_t i, const Observation &obs) {
+  int count = trueCount_
+                  ? State::bucketTrueCount(games_[i].getTrueCount())
+                  : 0;
+  states_[i] = GameStateConverter::toAIState(obs, count);
+  masks_[i] = obs.legalActions;
+}
+
+} // namespace ai
+} // namespace blackjack
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../game/BlackjackGame.hpp"
+#include "Agent.hpp"
+#include "State.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace blackjack {
+namespace ai {
+
+/**
+ * @brief N blackjack games stepped together over contiguous arrays
+ *
+ * Game i plays shoe stream firstStream + i of one seed. Every game always
+ * sits at a decision: states()[i] and validActions()[i] describe it, and
+ * step() applies actions[i] to game i. A round that ends is settled into
+ * rewards()/dones() and the game deals again at once (auto-reset), so
+ * states()[i] is then the new round's first decision; rounds that end on
+ * the deal (naturals) are settled into the totals and skipped.
+ */
+class VectorEnv {
+public:
+  /** trueCount: fill State::trueCount from each game's Hi-Lo count (for
+   *  agents whose usesTrueCount() is true). */
+  VectorEnv(const GameRules &rules, size_t numEnvs,
+            std::optional<uint32_t> seed = std::nullopt,
+            uint64_t firstStream = 0, bool trueCount = false,
+            ShuffleMode mode = ShuffleMode::UPFRONT);
+
+  size_t size() const { return games_.size(); }
+
+  const std::vector<State> &states() const { return states_; }
+  const std::vector<ActionMask> &validActions() const { return masks_; }
+
+  /** One action per game. @throws std::invalid_argument on a size
+   *  mismatch */
+  void step(const std::vector<Action> &actions);
+
+  /** Reward of the round game i finished on the last step() (every hand,
+   *  doubled hands twice; see GameStateConverter::outcomeToReward), 0 if
+   *  it is still playing. */
+  const std::vector<double> &rewards() const { return rewards_; }
+  /** 1 where the last step() finished game i's round. */
+  const std::vector<uint8_t> &dones() const { return dones_; }
+
+  /** Rounds finished across all games, naturals included. */
+  size_t roundsPlayed() const { return roundsPlayed_; }
+  /** Sum of every finished round's reward, naturals included. */
+  double totalReward() const { return totalReward_; }
+
+  const BlackjackGame &game(size_t i) const { return games_[i]; }
+
+private:
+  std::vector<BlackjackGame> games_;
+  bool trueCount_;
+
+  std::vector<State> states_;
+  std::vector<ActionMask> masks_;
+  std::vector<double> rewards_;
+  std::vector<uint8_t> dones_;
+  size_t roundsPlayed_ = 0;
+  double totalReward_ = 0.0;
+
+  /** Reward of game i's finished round, added to the totals. */
+  double settle(size_t i);
+  /** Deal game i until it reaches a decision. */
+  void deal(size_t i);
+  void observe(size_t i, const Observation &obs);
+};
+
+} // namespace ai
+} // namespace blackjack
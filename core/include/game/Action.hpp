@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+
+namespace blackjack {
+
+/** A player decision. Part of the game's vocabulary (BlackjackGame::step()
+ *  takes one); agents use it as ai::Action. */
+enum class Action : uint8_t { HIT = 0, STAND = 1, DOUBLE = 2, SPLIT = 3, SURRENDER = 4 };
+
+inline std::string actionToString(Action action) {
+  switch (action) {
+  case Action::HIT:
+    return "HIT";
+  case Action::STAND:
+    return "STAND";
+  case Action::DOUBLE:
+    return "DOUBLE";
+  case Action::SPLIT:
+    return "SPLIT";
+  case Action::SURRENDER:
+    return "SURRENDER";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+/** Set of actions, one bit (1 << action) each. Fits in a byte, never
+ *  allocates, and iterates in action order (HIT, STAND, DOUBLE, SPLIT,
+ *  SURRENDER). */
+class ActionMask {
+public:
+  constexpr ActionMask() = default;
+  constexpr ActionMask(std::initializer_list<Action> actions) {
+    for (Action action : actions) {
+      bits_ |= bit(action);
+    }
+  }
+
+  static constexpr ActionMask fromBits(uint8_t bits) {
+    ActionMask mask;
+    mask.bits_ = bits;
+    return mask;
+  }
+  /** HIT and STAND: always legal on a live hand. */
+  static constexpr ActionMask base() {
+    return ActionMask{Action::HIT, Action::STAND};
+  }
+
+  constexpr uint8_t bits() const { return bits_; }
+  constexpr bool empty() const { return bits_ == 0; }
+  constexpr bool contains(Action action) const {
+    return (bits_ & bit(action)) != 0;
+  }
+  constexpr size_t size() const {
+    size_t n = 0;
+    for (uint8_t rest = bits_; rest != 0; rest &= rest - 1) {
+      ++n;
+    }
+    return n;
+  }
+
+  constexpr void insert(Action action) { bits_ |= bit(action); }
+  constexpr void erase(Action action) {
+    bits_ &= static_cast<uint8_t>(~bit(action));
+  }
+
+  /** Lowest action in the set; HIT if empty. */
+  constexpr Action front() const { return nth(0); }
+
+  /** The index-th action in iteration order (index < size()). */
+  constexpr Action nth(size_t index) const {
+    uint8_t rest = bits_;
+    for (; index > 0 && rest != 0; --index) {
+      rest &= rest - 1;
+    }
+    return lowest(rest);
+  }
+
+  constexpr bool operator==(ActionMask other) const {
+    return bits_ == other.bits_;
+  }
+  constexpr bool operator!=(ActionMask other) const {
+    return bits_ != other.bits_;
+  }
+
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Action;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Action *;
+    using reference = Action;
+
+    constexpr explicit iterator(uint8_t rest = 0) : rest_(rest) {}
+    constexpr Action operator*() const { return lowest(rest_); }
+    constexpr iterator &operator++() {
+      rest_ &= rest_ - 1;
+      return *this;
+    }
+    constexpr iterator operator++(int) {
+      iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    constexpr bool operator!=(iterator other) const {
+      return rest_ != other.rest_;
+    }
+    constexpr bool operator==(iterator other) const {
+      return rest_ == other.rest_;
+    }
+
+  private:
+    uint8_t rest_;
+  };
+
+  constexpr iterator begin() const { return iterator(bits_); }
+  constexpr iterator end() const { return iterator(0); }
+
+private:
+  uint8_t bits_ = 0;
+
+  static constexpr uint8_t bit(Action action) {
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(action));
+  }
+  static constexpr Action lowest(uint8_t bits) {
+    unsigned index = 0;
+    while (bits != 0 && !(bits & 1u)) {
+      bits >>= 1;
+      ++index;
+    }
+    return static_cast<Action>(index);
+  }
+};
+
+} // namespace blackjack
@@ -1,4 +1,5 @@
 #include "BlackjackGame.hpp"
+#include <algorithm>
 #include <optional>
 #include <stdexcept>
 
@@ -26,10 +27,18 @@ std::string outcomeToString(Outcome outcome) {
 }
 
 BlackjackGame::BlackjackGame(const GameRules &rules,
-                             std::optional<uint32_t> seed)
-    : rules_(rules), deck_(std::make_unique<Deck>(rules.numDecks, seed)),
-      playerHands_(1), currentHandIndex_(0), splitUsed_(false),
-      roundComplete_(false) {}
+                             std::optional<uint32_t> seed, uint64_t stream,
+                             ShuffleMode mode)
+    : rules_(rules),
+      deck_(std::make_unique<Deck>(rules.numDecks, seed, stream, mode)),
+      maxHands_(1 + static_cast<size_t>(std::max(0, rules.maxSplits))),
+      playerHands_(1), currentHandIndex_(0), splitAces_(false),
+      roundComplete_(false) {
+  // Room for every hand a round can split into: splits never reallocate
+  playerHands_.reserve(maxHands_);
+  outcomes_.reserve(maxHands_);
+  doubledByHand_.reserve(maxHands_);
+}
 
 void BlackjackGame::startRound() {
   checkAndReshuffle();
@@ -44,8 +53,28 @@ void BlackjackGame::startRound() {
   dealerHand_.addCard(deck_->deal());
   dealerHand_.addCard(deck_->deal());
 
+  beginRound();
+}
+
+void BlackjackGame::startRound(const Card &first, const Card &second,
+                               const Card &dealerUpCard) {
+  checkAndReshuffle();
+
+  playerHands_.clear();
+  playerHands_.emplace_back();
+  playerHands_.back().addCard(first);
+  playerHands_.back().addCard(second);
+
+  dealerHand_.clear();
+  dealerHand_.addCard(dealerUpCard);
+  dealerHand_.addCard(deck_->deal());
+
+  beginRound();
+}
+
+void BlackjackGame::beginRound() {
   currentHandIndex_ = 0;
-  splitUsed_ = false;
+  splitAces_ = false;
   roundComplete_ = false;
   outcome_.reset();
   outcomes_.clear();
@@ -58,8 +87,61 @@ void BlackjackGame::startRound() {
   }
 }
 
-bool BlackjackGame::hit() {
+Observation BlackjackGame::observe() const {
+  Observation obs;
   if (roundComplete_) {
+    return obs;
+  }
+
+  const Hand &cur = playerHands_[currentHandIndex_];
+  const Hand::Value value = cur.getValue();
+  obs.playerTotal = static_cast<uint8_t>(value.total);
+  obs.dealerUpCard =
+      static_cast<uint8_t>(dealerHand_.getCards().front().getValue());
+  obs.soft = value.isSoft;
+  obs.cardCount = static_cast<uint8_t>(cur.size());
+  obs.handIndex = static_cast<uint8_t>(currentHandIndex_);
+  // A split ace only waits here to be resplit; it takes no more cards
+  obs.legalActions = splitAces_ ? ActionMask{Action::STAND} : ActionMask::base();
+  if (canDoubleDown()) {
+    obs.legalActions.insert(Action::DOUBLE);
+  }
+  if (canSplit()) {
+    obs.legalActions.insert(Action::SPLIT);
+  }
+  if (canSurrender()) {
+    obs.legalActions.insert(Action::SURRENDER);
+  }
+  obs.done = false;
+  return obs;
+}
+
+Observation BlackjackGame::step(Action action) {
+  switch (action) {
+  case Action::HIT:
+    hit();
+    break;
+  case Action::STAND:
+    stand();
+    break;
+  case Action::DOUBLE:
+    if (!doubleDown()) {
+      hit();
+    }
+    break;
+  case Action::SPLIT:
+    split();
+    break;
+  case Action::SURRENDER:
+    surrender();
+    break;
+  }
+  return observe();
+}
+
+bool BlackjackGame::hit() {
+  // Split aces take no cards beyond the one dealt on the split
+  if (roundComplete_ || splitAces_) {
     return false;
   }
 
@@ -67,12 +149,7 @@ bool BlackjackGame::hit() {
   cur.addCard(deck_->deal());
 
   if (cur.isBust()) {
-    if (currentHandIndex_ + 1 < playerHands_.size()) {
-      currentHandIndex_++;
-    } else {
-      finishRoundAndResolveOutcomes();
-    }
-    return true;
+    playFrom(currentHandIndex_ + 1);
   }
 
   return true;
@@ -83,11 +160,7 @@ void BlackjackGame::stand() {
     return;
   }
 
-  if (currentHandIndex_ + 1 < playerHands_.size()) {
-    currentHandIndex_++;
-  } else {
-    finishRoundAndResolveOutcomes();
-  }
+  playFrom(currentHandIndex_ + 1);
 }
 
 bool BlackjackGame::doubleDown() {
@@ -96,22 +169,8 @@ bool BlackjackGame::doubleDown() {
   }
 
   doubledByHand_[currentHandIndex_] = true;
-  Hand &cur = playerHands_[currentHandIndex_];
-  cur.addCard(deck_->deal());
-
-  if (cur.isBust()) {
-    if (currentHandIndex_ + 1 < playerHands_.size()) {
-      currentHandIndex_++;
-    } else {
-      finishRoundAndResolveOutcomes();
-    }
-  } else {
-    if (currentHandIndex_ + 1 < playerHands_.size()) {
-      currentHandIndex_++;
-    } else {
-      finishRoundAndResolveOutcomes();
-    }
-  }
+  playerHands_[currentHandIndex_].addCard(deck_->deal());
+  playFrom(currentHandIndex_ + 1);
 
   return true;
 }
@@ -131,7 +190,10 @@ bool BlackjackGame::split() {
     return false;
   }
 
-  Hand &first = playerHands_[0];
+  // The new hand is played right after this one, as at the table
+  const size_t index = currentHandIndex_;
+  Hand &first = playerHands_[index];
+  const bool aces = first.getCards()[0].isAce();
   Card secondCard = first.split();
 
   Hand secondHand;
@@ -139,10 +201,13 @@ bool BlackjackGame::split() {
   secondHand.addCard(deck_->deal());
   first.addCard(deck_->deal());
 
-  playerHands_.push_back(std::move(secondHand));
-  doubledByHand_.push_back(false);
-  splitUsed_ = true;
-  currentHandIndex_ = 0;
+  // Within the capacity reserved at construction: no reallocation
+  playerHands_.insert(playerHands_.begin() + index + 1, secondHand);
+  doubledByHand_.insert(doubledByHand_.begin() + index + 1, false);
+  splitAces_ = splitAces_ || aces;
+
+  // Split aces stand on their one card unless they can be resplit
+  playFrom(index);
 
   return true;
 }
@@ -167,6 +232,13 @@ Hand BlackjackGame::getDealerHand(bool hideHoleCard) const {
   return dealerHand_;
 }
 
+const Card &BlackjackGame::getDealerUpCard() const {
+  if (dealerHand_.empty()) {
+    throw std::logic_error("Dealer has no cards");
+  }
+  return dealerHand_.getCards().front();
+}
+
 bool BlackjackGame::canDoubleDown() const {
   if (roundComplete_) {
     return false;
@@ -175,21 +247,20 @@ bool BlackjackGame::canDoubleDown() const {
   if (cur.size() != 2) {
     return false;
   }
-  // No double after split in this implementation
-  if (splitUsed_ && playerHands_.size() > 1) {
-    return false;
+  if (playerHands_.size() > 1) {
+    return rules_.doubleAfterSplit && !splitAces_;
   }
   return true;
 }
 
 bool BlackjackGame::canSplit() const {
-  if (roundComplete_ || splitUsed_) {
+  if (roundComplete_ || playerHands_.size() >= maxHands_) {
     return false;
   }
-  if (playerHands_.size() != 1) {
+  if (!playerHands_[currentHandIndex_].canSplit()) {
     return false;
   }
-  return playerHands_[0].canSplit();
+  return !splitAces_ || rules_.resplitAces;
 }
 
 bool BlackjackGame::canSurrender() const {
@@ -202,6 +273,25 @@ bool BlackjackGame::canSurrender() const {
   return playerHands_[0].size() == 2;
 }
 
+double BlackjackGame::getTrueCount() const {
+  if (deck_->isInfinite()) {
+    return 0.0;
+  }
+  int runningCount = deck_->getRunningCount();
+  size_t unseen = deck_->cardsRemaining();
+
+  const auto &dealerCards = dealerHand_.getCards();
+  if (!roundComplete_ && dealerCards.size() >= 2) {
+    runningCount -= Deck::hiLoTag(dealerCards[1]);
+    ++unseen;
+  }
+
+  if (unseen == 0) {
+    return 0.0;
+  }
+  return runningCount / (unseen / 52.0);
+}
+
 void BlackjackGame::reset() {
   deck_->reset();
   playerHands_.clear();
@@ -209,12 +299,25 @@ void BlackjackGame::reset() {
   doubledByHand_.assign(1, false);
   dealerHand_.clear();
   currentHandIndex_ = 0;
-  splitUsed_ = false;
+  splitAces_ = false;
   roundComplete_ = false;
   outcome_.reset();
   outcomes_.clear();
 }
 
+void BlackjackGame::playFrom(size_t index) {
+  // Only a split ace that can be resplit still has a decision to make
+  currentHandIndex_ = index;
+  while (currentHandIndex_ < playerHands_.size() && splitAces_ &&
+         !canSplit()) {
+    ++currentHandIndex_;
+  }
+  if (currentHandIndex_ == playerHands_.size()) {
+    currentHandIndex_ = playerHands_.size() - 1;
+    finishRoundAndResolveOutcomes();
+  }
+}
+
 void BlackjackGame::playDealerHand() {
   while (true) {
     int total = dealerHand_.getTotal();
@@ -239,7 +342,8 @@ void BlackjackGame::playDealerHand() {
 }
 
 Outcome BlackjackGame::determineOutcome(const Hand &playerHand) const {
-  bool playerBlackjack = playerHand.isBlackjack();
+  // A two-card 21 on a split hand is an ordinary 21
+  bool playerBlackjack = playerHand.isBlackjack() && playerHands_.size() == 1;
   bool dealerBlackjack = dealerHand_.isBlackjack();
 
   if (playerBlackjack && dealerBlackjack) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Action.hpp"
 #include "GameRules.hpp"
 #include "Deck.hpp"
 #include "Hand.hpp"
@@ -21,14 +22,51 @@ namespace blackjack {
 
     std::string outcomeToString(Outcome outcome);
 
+    /** One decision point, computed once: what a policy keys on plus the
+     *  legal actions. Trivially copyable, 7 bytes. Once the round is over
+     *  only done is set (every other field zero, no legal actions). */
+    struct Observation {
+        uint8_t playerTotal = 0;  ///< best total of the hand to act
+        uint8_t dealerUpCard = 0; ///< 1-10, ace = 1
+        bool soft = false;        ///< an ace in the total counts 11
+        uint8_t cardCount = 0;    ///< cards in the hand to act
+        uint8_t handIndex = 0;    ///< hand to act (1 = second split hand)
+        ActionMask legalActions;  ///< canDoubleDown/canSplit/canSurrender
+        bool done = true;         ///< round complete
+    };
+
     /** Single-player vs dealer; manages state, rules, and dealer play.
-     *  Supports one split per round (no resplit); hands played sequentially. */
+     *  Splits follow GameRules: up to maxSplits per round, aces resplit only
+     *  with resplitAces, double after split with doubleAfterSplit. Split
+     *  aces get one card each; a two-card 21 after a split is not a
+     *  blackjack. Hands are played in order, each split hand right after
+     *  the hand it came from. */
     class BlackjackGame {
     public:
+        /** seed/stream: the shoe's RNG stream; mode: how it shuffles (see
+         *  Deck). */
         explicit BlackjackGame(const GameRules& rules = GameRules{},
-                               std::optional<uint32_t> seed = std::nullopt);
+                               std::optional<uint32_t> seed = std::nullopt,
+                               uint64_t stream = 0,
+                               ShuffleMode mode = ShuffleMode::UPFRONT);
         void startRound();
 
+        /** Exploring start: the player's two cards and the dealer's upcard
+         *  are the given ones; the hole card and everything after come from
+         *  the shoe and the round plays normally (naturals included). The
+         *  given cards never pass through the shoe, so they are neither
+         *  removed from it nor counted. */
+        void startRound(const Card& first, const Card& second,
+                        const Card& dealerUpCard);
+
+        /** The current decision point (see Observation). */
+        Observation observe() const;
+
+        /** Plays action on the current hand and observes the result. An
+         *  illegal DOUBLE hits instead; any other illegal action is ignored
+         *  and the same decision point comes back. */
+        Observation step(Action action);
+
         /** @return true if action was applied. */
         bool hit();
         void stand();
@@ -36,7 +74,8 @@ namespace blackjack {
         /** @return true if action was applied. */
         bool doubleDown();
 
-        /** @return true if split was performed (one split only, no resplit). */
+        /** Splits the current hand in two, one new card each.
+         *  @return true if split was performed (see canSplit()). */
         bool split();
 
         /** @return true if surrender was applied (only on first two cards; gated by rules.surrender). */
@@ -56,23 +95,46 @@ namespace blackjack {
         /** Current hand (single hand index when multiple hands). */
         const Hand& getPlayerHand() const;
 
+        /** Player hands this round: 1 + splits made. */
+        size_t getNumHands() const { return playerHands_.size(); }
+
         /** hideHoleCard: true to show only upcard (e.g. during player turn). */
         Hand getDealerHand(bool hideHoleCard = false) const;
 
+        /** Dealer's face-up card, read in place.
+         *  @throws std::logic_error before the first deal. */
+        const Card& getDealerUpCard() const;
+
+        /** True on a two-card hand; after a split only with
+         *  rules.doubleAfterSplit, and never on split aces. */
         bool canDoubleDown() const;
-        /** True if current hand can split and no split has been used this round. */
+        /** True if the current hand is a pair, the round has fewer than
+         *  1 + rules.maxSplits hands, and (for aces already split)
+         *  rules.resplitAces. */
         bool canSplit() const;
         /** True if surrender is allowed (rules + first two cards, single hand). */
         bool canSurrender() const;
         const GameRules& getRules() const { return rules_; }
+
+        /** The shoe, for composition queries (Deck::remainingOfValue()).
+         *  The dealer's hole card is already out of it. */
+        const Deck& getDeck() const { return *deck_; }
+
+        /** Hi-Lo true count of the cards a player can see: the dealer's hole
+         *  card is left out (and counted as unseen) until the round ends. */
+        double getTrueCount() const;
+
         void reset();
 
     private:
         GameRules rules_;
         std::unique_ptr<Deck> deck_;
+        /** 1 + rules.maxSplits; the hand vectors reserve this many. */
+        size_t maxHands_;
         std::vector<Hand> playerHands_;
         size_t currentHandIndex_;
-        bool splitUsed_;
+        /** This round's pair was aces and has been split. */
+        bool splitAces_;
         Hand dealerHand_;
         bool roundComplete_;
         std::optional<Outcome> outcome_;
@@ -81,6 +143,12 @@ namespace blackjack {
         /** One bool per hand: true if that hand was doubled down. */
         std::vector<bool> doubledByHand_;
 
+        /** Reset per-round state for a just-dealt round; settles naturals. */
+        void beginRound();
+        /** Make hand index current, skipping split aces that cannot be
+         *  resplit; past the last hand, the dealer plays and the round
+         *  settles. */
+        void playFrom(size_t index);
         void playDealerHand();
         Outcome determineOutcome(const Hand& playerHand) const;
         void finishRoundAndResolveOutcomes();
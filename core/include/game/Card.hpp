@@ -38,6 +38,11 @@ public:
    */
   constexpr Card(Rank rank, Suit suit) noexcept : rank_(rank), suit_(suit) {}
 
+  /**
+   * @brief Placeholder (ace of spades) for fixed-capacity card storage
+   */
+  constexpr Card() noexcept : rank_(Rank::ACE), suit_(Suit::SPADES) {}
+
   /**
    * @brief Get the card's rank
    */
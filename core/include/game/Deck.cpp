@@ -1,24 +1,24 @@
 #include "Deck.hpp"
 #include <algorithm>
 #include <optional>
-#include <random>
 #include <stdexcept>
 
 namespace blackjack {
 
-Deck::Deck(size_t numDecks, std::optional<uint32_t> seed)
-    : currentIndex_(0), numDecks_(numDecks),
-      rng_(seed ? *seed : std::random_device{}()) {
-  if (numDecks == 0) {
-    throw std::invalid_argument("Number of decks must be at least 1");
-  }
-
+Deck::Deck(size_t numDecks, std::optional<uint32_t> seed, uint64_t stream,
+           ShuffleMode mode)
+    : totalCards_(52 * numDecks), currentIndex_(0), numDecks_(numDecks),
+      mode_(mode),
+      rng_(seed ? *seed : randomSeed(), stream) {
   initializeDeck();
   shuffle();
 }
 
 void Deck::initializeDeck() {
   cards_.clear();
+  if (mode_ == ShuffleMode::RANK_COUNTS) {
+    return;
+  }
   cards_.reserve(52 * numDecks_);
 
   for (size_t deck = 0; deck < numDecks_; ++deck) {
@@ -31,22 +31,78 @@ void Deck::initializeDeck() {
 }
 
 void Deck::shuffle() {
-  // Fisher-Yates shuffle
-  for (size_t i = cards_.size() - 1; i > 0; --i) {
-    std::uniform_int_distribution<size_t> dist(0, i);
-    size_t j = dist(rng_);
-    std::swap(cards_[i], cards_[j]);
+  if (mode_ == ShuffleMode::UPFRONT) {
+    fisherYatesShuffle(cards_.begin(), cards_.size(), rng_);
   }
 
+  // Aces through nines four per deck, sixteen tens
+  const uint32_t decks = isInfinite() ? 1 : static_cast<uint32_t>(numDecks_);
+  composition_.fill(4 * decks);
+  composition_[9] = 16 * decks;
+  tenRanks_.fill(4 * decks);
   currentIndex_ = 0;
+  runningCount_ = 0;
 }
 
 Card Deck::deal() {
-  if (currentIndex_ >= cards_.size()) {
+  if (isInfinite()) {
+    uint32_t index = boundedRandom(rng_, 52);
+    return Card(static_cast<Rank>(index % 13 + 1), static_cast<Suit>(index / 13));
+  }
+  if (currentIndex_ >= totalCards_) {
     throw std::runtime_error("Deck is empty");
   }
+  if (mode_ == ShuffleMode::RANK_COUNTS) {
+    return dealByRankCount();
+  }
 
-  return cards_[currentIndex_++];
+  if (mode_ == ShuffleMode::LAZY) {
+    // One forward Fisher-Yates step: a uniform pick of the undealt cards
+    size_t undealt = cards_.size() - currentIndex_;
+    size_t j =
+        currentIndex_ + boundedRandom(rng_, static_cast<uint32_t>(undealt));
+    std::swap(cards_[currentIndex_], cards_[j]);
+  }
+
+  const Card &card = cards_[currentIndex_++];
+  --composition_[card.getValue() - 1];
+  runningCount_ += hiLoTag(card);
+  return card;
+}
+
+Card Deck::dealByRankCount() {
+  // Uniform over the undealt cards, located by value
+  uint32_t pick = boundedRandom(
+      rng_, static_cast<uint32_t>(totalCards_ - currentIndex_));
+  size_t value = 0;
+  while (pick >= composition_[value]) {
+    pick -= composition_[value];
+    ++value;
+  }
+  --composition_[value];
+  ++currentIndex_;
+
+  // pick now indexes the value's remaining cards; a ten also picks its
+  // rank from what is left of 10/J/Q/K, since splitting compares ranks
+  size_t rank = value;
+  if (value == 9) {
+    while (pick >= tenRanks_[rank - 9]) {
+      pick -= tenRanks_[rank - 9];
+      ++rank;
+    }
+    --tenRanks_[rank - 9];
+  }
+  Card card(static_cast<Rank>(rank + 1), static_cast<Suit>(pick % 4));
+  runningCount_ += hiLoTag(card);
+  return card;
+}
+
+double Deck::getTrueCount() const {
+  size_t remaining = cardsRemaining();
+  if (remaining == 0) {
+    return 0.0;
+  }
+  return runningCount_ / (remaining / 52.0);
 }
 
 bool Deck::needsReshuffle(double penetration) const {
@@ -54,15 +110,16 @@ bool Deck::needsReshuffle(double penetration) const {
     throw std::invalid_argument("Penetration must be between 0 and 1");
   }
 
+  if (isInfinite()) {
+    return false;
+  }
+
   size_t cardsDealt = currentIndex_;
-  size_t threshold = static_cast<size_t>(cards_.size() * penetration);
+  size_t threshold = static_cast<size_t>(totalCards_ * penetration);
 
   return cardsDealt >= threshold;
 }
 
-void Deck::reset() {
-  initializeDeck();
-  shuffle();
-}
+void Deck::reset() { shuffle(); }
 
 } // namespace blackjack
\ No newline at end of file
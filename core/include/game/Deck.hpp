@@ -1,36 +1,97 @@
 #pragma once
 
 #include "Card.hpp"
+#include "Random.hpp"
+#include <array>
+#include <cstdint>
 #include <optional>
-#include <random>
 #include <vector>
 
 namespace blackjack {
 
-/** Deck of cards; supports multiple 52-card decks and Fisher-Yates shuffle. */
+/** How Deck randomizes its order. All deal uniformly random shoes. */
+enum class ShuffleMode {
+  UPFRONT, ///< Fisher-Yates over the whole shoe at every shuffle()
+  LAZY,    ///< shuffle() is O(1); deal() swaps a random undealt card forward.
+           ///< Draws one RNG output per dealt card instead of one per three
+           ///< shuffled, so it only pays off at low penetration.
+  RANK_COUNTS ///< No card array: the shoe is its ten rank-value counts plus
+              ///< per-rank counts of 10/J/Q/K (splits compare ranks), and
+              ///< deal() picks a card in proportion to what is left. Only
+              ///< suits are assigned arbitrarily; play never sees them.
+};
+
+/** Deck of cards; supports multiple 52-card decks and Fisher-Yates shuffle.
+ *  numDecks = 0 is an infinite deck: deal() draws each of the 52 cards with
+ *  probability 1/52 from no card array at all, nothing is ever removed, and
+ *  there is nothing to count (running and true count stay 0). */
 class Deck {
 public:
-  explicit Deck(size_t numDecks = 1, std::optional<uint32_t> seed = std::nullopt);
+  /** Shuffles with stream `stream` of seed (random seed if nullopt); decks
+   *  built from one seed with different streams are independent. */
+  explicit Deck(size_t numDecks = 1, std::optional<uint32_t> seed = std::nullopt,
+                uint64_t stream = 0, ShuffleMode mode = ShuffleMode::UPFRONT);
 
+  /** Gathers every card back and reshuffles in place: Fisher-Yates from the
+   *  current order (any order is a valid start), one draw per three cards
+   *  (fisherYatesShuffle). In LAZY and RANK_COUNTS modes only the deal
+   *  position, count and composition reset. */
   void shuffle();
 
   /** @throws std::runtime_error if deck is empty */
   Card deal();
 
-  /** penetration: fraction of deck dealt before reshuffling (default 0.75). */
+  /** penetration: fraction of deck dealt before reshuffling (default 0.75).
+   *  Never true for an infinite deck. */
   bool needsReshuffle(double penetration = 0.75) const;
 
-  size_t cardsRemaining() const { return cards_.size() - currentIndex_; }
-  size_t totalCards() const { return cards_.size(); }
+  bool isInfinite() const { return numDecks_ == 0; }
+  /** SIZE_MAX for an infinite deck. */
+  size_t cardsRemaining() const {
+    return isInfinite() ? SIZE_MAX : totalCards_ - currentIndex_;
+  }
+  /** 0 for an infinite deck. */
+  size_t totalCards() const { return totalCards_; }
+  ShuffleMode getShuffleMode() const { return mode_; }
+  /** Same as shuffle(). */
   void reset();
 
+  /** Undealt cards worth `value` (1 = ace ... 10 = any ten), O(1) in every
+   *  mode. An infinite deck reports one fresh deck, its draw proportions.
+   *  @throws std::out_of_range unless 1 <= value <= 10 */
+  uint32_t remainingOfValue(int value) const {
+    return composition_.at(static_cast<size_t>(value - 1));
+  }
+  /** remainingOfValue() for every value, aces first. */
+  const std::array<uint32_t, 10> &getComposition() const {
+    return composition_;
+  }
+
+  /** Hi-Lo running count of every card dealt since the last shuffle. */
+  int getRunningCount() const { return runningCount_; }
+
+  /** Running count per deck left in the shoe (0 when the shoe is empty). */
+  double getTrueCount() const;
+
+  /** Hi-Lo tag: 2-6 count +1, 7-9 count 0, tens and aces count -1. */
+  static constexpr int hiLoTag(const Card &card) noexcept {
+    int value = card.getValue();
+    return (value >= 2 && value <= 6) ? 1 : (value >= 7 && value <= 9) ? 0 : -1;
+  }
+
 private:
-  std::vector<Card> cards_;
-  size_t currentIndex_;
+  std::vector<Card> cards_; // empty for RANK_COUNTS and infinite decks
+  std::array<uint32_t, 10> composition_ = {};
+  std::array<uint32_t, 4> tenRanks_ = {}; // 10/J/Q/K left, RANK_COUNTS only
+  size_t totalCards_;
+  size_t currentIndex_; // cards dealt since the last shuffle
+  int runningCount_ = 0;
   const size_t numDecks_;
-  std::mt19937 rng_;
+  const ShuffleMode mode_;
+  Rng rng_;
 
   void initializeDeck();
+  Card dealByRankCount();
 };
 
 } // namespace blackjack
\ No newline at end of file
@@ -6,7 +6,7 @@ namespace blackjack {
 
 /** House rules and table config. */
 struct GameRules {
-    size_t numDecks = 6;
+    size_t numDecks = 6;  // 0 = infinite deck (every rank 1/13, no shoe)
     bool dealerHitsSoft17 = true;
     double blackjackPayout = 1.5;  // 3:2 = 1.5, 6:5 = 1.2
     bool doubleAfterSplit = true;
@@ -15,6 +15,9 @@ struct GameRules {
     bool surrender = false;
     double penetration = 0.75;  // fraction of shoe dealt before reshuffle
 
+    /** No shoe: every card is an independent 1-in-13 rank draw. */
+    bool isInfiniteDeck() const { return numDecks == 0; }
+
     /** Returns stake + winnings (blackjack uses blackjackPayout multiplier). */
     double getPayout(double bet, bool isBlackjack) const {
         if (isBlackjack) {
@@ -6,48 +6,24 @@
 namespace blackjack {
 
 void Hand::addCard(const Card &card) {
-  cards_.push_back(card);
-  cachedValue_.reset();
-}
-
-void Hand::clear() {
-  cards_.clear();
-  cachedValue_.reset();
-}
-
-Hand::Value Hand::getValue() const {
-  if (cachedValue_) {
-    return *cachedValue_;
-  }
-
-  int total = 0;
-  int aces = 0;
-
-  // First pass: count aces as 11
-  for (const auto &card : cards_) {
-    if (card.isAce()) {
-      aces++;
-      total += 11;
-    } else {
-      total += card.getValue();
-    }
+  if (count_ == MAX_CARDS) {
+    throw std::length_error("Hand is full");
   }
-
-  // Second pass: convert aces from 11 to 1 if bust
-  while (total > 21 && aces > 0) {
-    total -= 10; // Convert one ace from 11 to 1
-    aces--;
+  cards_[count_++] = card;
+  hardTotal_ += card.getValue();
+  if (card.isAce()) {
+    ++aces_;
   }
+}
 
-  // Hand is soft if it has at least one ace still counting as 11
-  bool isSoft = (aces > 0) && (total <= 21);
-
-  cachedValue_ = {total, isSoft};
-  return *cachedValue_;
+void Hand::clear() {
+  count_ = 0;
+  aces_ = 0;
+  hardTotal_ = 0;
 }
 
 bool Hand::isBlackjack() const {
-  if (cards_.size() != 2) {
+  if (count_ != 2) {
     return false;
   }
 
@@ -55,7 +31,7 @@ bool Hand::isBlackjack() const {
 }
 
 bool Hand::canSplit() const {
-  if (cards_.size() != 2) {
+  if (count_ != 2) {
     return false;
   }
 
@@ -64,14 +40,14 @@ bool Hand::canSplit() const {
 }
 
 std::string Hand::toString() const {
-  if (cards_.empty()) {
+  if (empty()) {
     return "Empty hand";
   }
 
   std::ostringstream oss;
   oss << "[";
 
-  for (size_t i = 0; i < cards_.size(); ++i) {
+  for (size_t i = 0; i < count_; ++i) {
     if (i > 0) {
       oss << ", ";
     }
@@ -102,8 +78,11 @@ Card Hand::split() {
   }
 
   Card secondCard = cards_[1];
-  cards_.pop_back();
-  cachedValue_.reset();
+  count_ = 1;
+  hardTotal_ -= secondCard.getValue();
+  if (secondCard.isAce()) {
+    --aces_;
+  }
 
   return secondCard;
 }
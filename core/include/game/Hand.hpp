@@ -1,15 +1,21 @@
 #pragma once
 
 #include "Card.hpp"
-#include <optional>
+#include <array>
+#include <cstdint>
 #include <string>
-#include <vector>
 
 namespace blackjack {
 
-/** Player or dealer hand; value calculation handles soft/hard aces. */
+/** Player or dealer hand; value calculation handles soft/hard aces.
+ *  Cards live inline (no heap), and the hard total and ace count are kept
+ *  up to date as cards arrive, so copying a hand or reading its value never
+ *  allocates or rescans. */
 class Hand {
 public:
+  /** Longest possible hand: 21 one-point cards plus the card that busts it. */
+  static constexpr size_t MAX_CARDS = 22;
+
   struct Value {
     int total;
     bool isSoft; // usable ace counting as 11
@@ -19,21 +25,45 @@ public:
     }
   };
 
+  /** Read-only view of a hand's cards in deal order; valid while the hand
+   *  is alive and unchanged. */
+  class Cards {
+  public:
+    constexpr Cards(const Card *data, size_t size) : data_(data), size_(size) {}
+
+    constexpr const Card *begin() const { return data_; }
+    constexpr const Card *end() const { return data_ + size_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr const Card &operator[](size_t i) const { return data_[i]; }
+    constexpr const Card &front() const { return data_[0]; }
+    constexpr const Card &back() const { return data_[size_ - 1]; }
+
+  private:
+    const Card *data_;
+    size_t size_;
+  };
+
   Hand() = default;
+
+  /** @throws std::length_error past MAX_CARDS (unreachable in play). */
   void addCard(const Card &card);
   void clear();
 
   /** Soft aces count as 11 until that would bust, then as 1. */
-  Value getValue() const;
+  Value getValue() const {
+    bool soft = aces_ > 0 && hardTotal_ + 10 <= 21;
+    return {soft ? hardTotal_ + 10 : hardTotal_, soft};
+  }
 
   int getTotal() const { return getValue().total; }
   bool isSoft() const { return getValue().isSoft; }
   bool isBlackjack() const;
-  bool isBust() const { return getTotal() > 21; }
+  bool isBust() const { return hardTotal_ > 21; }
   bool canSplit() const;
-  size_t size() const { return cards_.size(); }
-  bool empty() const { return cards_.empty(); }
-  const std::vector<Card> &getCards() const { return cards_; }
+  size_t size() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  Cards getCards() const { return Cards(cards_.data(), count_); }
   std::string toString() const;
 
   /** @return Second card (first remains in this hand). @throws std::logic_error
@@ -41,8 +71,10 @@ public:
   Card split();
 
 private:
-  std::vector<Card> cards_;
-  mutable std::optional<Value> cachedValue_;
+  std::array<Card, MAX_CARDS> cards_;
+  uint8_t count_ = 0;
+  uint8_t aces_ = 0;
+  int hardTotal_ = 0; // every ace counted as 1
 };
 
-} // namespace blackjack
\ No newline at end of file
+} // namespace blackjack
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+namespace blackjack {
+
+/** SplitMix64 output function: a strong 64-bit mix, used to derive seeds. */
+constexpr uint64_t splitMix64(uint64_t x) noexcept {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/** Independent 32-bit seed for one component (salt) of a seeded run, so
+ *  e.g. the shoes and the agent's exploration never share a key. */
+constexpr uint32_t deriveSeed(uint32_t seed, uint64_t salt) noexcept {
+  return static_cast<uint32_t>(splitMix64(splitMix64(seed) ^ salt) >> 32);
+}
+
+/** Nondeterministic seed for unseeded runs. */
+inline uint32_t randomSeed() { return std::random_device{}(); }
+
+/**
+ * @brief Philox4x32-10 counter-based generator (Salmon et al., SC'11)
+ *
+ * Block n of stream s under key k is a pure function of (k, s, n): ten
+ * multiply/xor rounds over the 128-bit counter (n, s). Any stream is ready
+ * in O(1) with no warm-up, discard() seeks in O(1), and the whole state is
+ * 48 bytes (std::mt19937 is 5 KB), so every shoe, worker and evaluation
+ * shard can own a stream of one master seed. Passes BigCrush; 32-bit
+ * outputs, usable with the <random> distributions.
+ */
+class Philox4x32 {
+public:
+  using result_type = uint32_t;
+
+  explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0) noexcept
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        stream_(stream) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT32_MAX; }
+
+  result_type operator()() noexcept {
+    if (next_ == 4) {
+      block_ = generate(counter_++);
+      next_ = 0;
+    }
+    return block_[next_++];
+  }
+
+  /** Skip n outputs. */
+  void discard(uint64_t n) noexcept {
+    // Outputs consumed so far; wraps correctly before the first block
+    uint64_t position = (counter_ - 1) * 4 + next_ + n;
+    counter_ = position / 4;
+    next_ = 4;
+    if (position % 4 != 0) {
+      block_ = generate(counter_++);
+      next_ = static_cast<unsigned>(position % 4);
+    }
+  }
+
+  uint64_t stream() const { return stream_; }
+
+  /** The four outputs of block (counter, stream) under key; the KAT hook. */
+  static std::array<uint32_t, 4> block(uint64_t counter, uint64_t stream,
+                                       uint32_t key0, uint32_t key1) noexcept {
+    uint32_t c[4] = {static_cast<uint32_t>(counter),
+                     static_cast<uint32_t>(counter >> 32),
+                     static_cast<uint32_t>(stream),
+                     static_cast<uint32_t>(stream >> 32)};
+    for (int round = 0; round < 10; ++round) {
+      uint64_t p0 = uint64_t{0xD2511F53u} * c[0];
+      uint64_t p1 = uint64_t{0xCD9E8D57u} * c[2];
+      uint32_t next[4] = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ key0,
+                          static_cast<uint32_t>(p1),
+                          static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ key1,
+                          static_cast<uint32_t>(p0)};
+      c[0] = next[0];
+      c[1] = next[1];
+      c[2] = next[2];
+      c[3] = next[3];
+      key0 += 0x9E3779B9u;
+      key1 += 0xBB67AE85u;
+    }
+    return {c[0], c[1], c[2], c[3]};
+  }
+
+  bool operator==(const Philox4x32 &other) const {
+    return key_[0] == other.key_[0] && key_[1] == other.key_[1] &&
+           stream_ == other.stream_ && counter_ == other.counter_ &&
+           next_ == other.next_;
+  }
+  bool operator!=(const Philox4x32 &other) const { return !(*this == other); }
+
+private:
+  uint32_t key_[2];
+  uint64_t stream_;
+  uint64_t counter_ = 0;          // next block to generate
+  std::array<uint32_t, 4> block_ = {};
+  unsigned next_ = 4;             // index into block_; 4 = exhausted
+
+  std::array<uint32_t, 4> generate(uint64_t counter) const noexcept {
+    return block(counter, stream_, key_[0], key_[1]);
+  }
+};
+
+/**
+ * @brief Unbiased integer in [0, range) from one 32-bit draw (Lemire 2019)
+ *
+ * Multiplies instead of dividing; a modulo is taken, and a draw rejected,
+ * only in the rare low-product case (probability range / 2^32), so a
+ * Fisher-Yates swap costs one engine call and one multiply.
+ * Engine must produce full-range 32-bit outputs. range > 0.
+ */
+template <typename Engine>
+inline uint32_t boundedRandom(Engine &engine, uint32_t range) {
+  uint64_t product = uint64_t{engine()} * range;
+  uint32_t low = static_cast<uint32_t>(product);
+  if (low < range) {
+    uint32_t threshold = static_cast<uint32_t>(-range) % range;
+    while (low < threshold) {
+      product = uint64_t{engine()} * range;
+      low = static_cast<uint32_t>(product);
+    }
+  }
+  return static_cast<uint32_t>(product >> 32);
+}
+
+/**
+ * @brief Fisher-Yates shuffle of [first, first + size), three swaps per draw
+ *
+ * Batched ranged integers (Brackett-Luce & Lemire 2024): one 32-bit draw
+ * multiplied successively by n, n-1 and n-2 yields three independent
+ * uniform indices, rejected together only when the leftover falls below
+ * (2^32 - n(n-1)(n-2)) mod n(n-1)(n-2). Shoes of up to 31 decks take the
+ * batched path; the last few positions, and larger ranges, draw singly.
+ */
+template <typename RandomIt, typename Engine>
+void fisherYatesShuffle(RandomIt first, size_t size, Engine &engine) {
+  constexpr size_t MAX_BATCHED = 1625; // n(n-1)(n-2) < 2^32
+  size_t n = size;
+  for (; n > MAX_BATCHED; --n) {
+    uint32_t j = boundedRandom(engine, static_cast<uint32_t>(n));
+    std::swap(first[n - 1], first[j]);
+  }
+  for (; n >= 4; n -= 3) {
+    const uint32_t range = static_cast<uint32_t>(n);
+    const uint32_t bound = range * (range - 1) * (range - 2);
+    uint32_t j0, j1, j2;
+    while (true) {
+      uint64_t product = uint64_t{engine()} * range;
+      j0 = static_cast<uint32_t>(product >> 32);
+      product = (product & UINT32_MAX) * (range - 1);
+      j1 = static_cast<uint32_t>(product >> 32);
+      product = (product & UINT32_MAX) * (range - 2);
+      j2 = static_cast<uint32_t>(product >> 32);
+      uint32_t low = static_cast<uint32_t>(product);
+      if (low >= bound || low >= static_cast<uint32_t>(-bound) % bound) break;
+    }
+    std::swap(first[n - 1], first[j0]);
+    std::swap(first[n - 2], first[j1]);
+    std::swap(first[n - 3], first[j2]);
+  }
+  for (; n > 1; --n) {
+    uint32_t j = boundedRandom(engine, static_cast<uint32_t>(n));
+    std::swap(first[n - 1], first[j]);
+  }
+}
+
+/** The engine behind every Deck, shoe lane and exploring agent. Swap it here
+ *  for any engine constructible from (seed, stream). */
+using Rng = Philox4x32;
+
+} // namespace blackjack
@@ -0,0 +1,194 @@
+#include "DealerProbabilities.hpp"
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+namespace blackjack {
+namespace solver {
+
+namespace {
+
+/** Single-deck rank odds by blackjack value (tens and faces pooled). */
+constexpr double kInfiniteOdds[11] = {0.0,      1.0 / 13, 1.0 / 13, 1.0 / 13,
+                                      1.0 / 13, 1.0 / 13, 1.0 / 13, 1.0 / 13,
+                                      1.0 / 13, 1.0 / 13, 4.0 / 13};
+
+/** Exhaustive dealer draw. hardTotal counts aces as 1; comp is only
+ *  decremented when drawing from a finite shoe. */
+void dealerRecurse(Composition &comp, int remaining, bool infinite,
+                   int hardTotal, bool hasAce, int cards, double prob,
+                   int upCard, bool hitsSoft17, DealerOutcomes &out) {
+  bool soft = hasAce && hardTotal + 10 <= 21;
+  int total = soft ? hardTotal + 10 : hardTotal;
+
+  if (cards >= 2) {
+    if (total > 21) {
+      out.p[DealerOutcomes::BUST] += prob;
+      return;
+    }
+    if (total > 17 || (total == 17 && !(soft && hitsSoft17))) {
+      out.p[static_cast<size_t>(total - 17)] += prob;
+      return;
+    }
+  }
+
+  // Hole card: rounds where the dealer has blackjack never reach the player
+  int excluded = 0;
+  if (cards == 1) {
+    excluded = (upCard == 1) ? 10 : (upCard == 10) ? 1 : 0;
+  }
+
+  double denom;
+  if (infinite) {
+    denom = 1.0 - (excluded ? kInfiniteOdds[excluded] : 0.0);
+  } else {
+    denom = remaining - (excluded ? comp[excluded] : 0);
+    if (denom <= 0) {
+      return;
+    }
+  }
+
+  for (int card = 1; card <= 10; ++card) {
+    if (card == excluded) {
+      continue;
+    }
+    if (infinite) {
+      dealerRecurse(comp, remaining, true, hardTotal + card,
+                    hasAce || card == 1, cards + 1,
+                    prob * kInfiniteOdds[card] / denom, upCard, hitsSoft17,
+                    out);
+      continue;
+    }
+    if (comp[card] == 0) {
+      continue;
+    }
+    double p = prob * comp[card] / denom;
+    --comp[card];
+    dealerRecurse(comp, remaining - 1, false, hardTotal + card,
+                  hasAce || card == 1, cards + 1, p, upCard, hitsSoft17, out);
+    ++comp[card];
+  }
+}
+
+} // anonymous namespace
+
+Composition shoeComposition(size_t numDecks) {
+  Composition comp{};
+  for (int card = 1; card <= 9; ++card) {
+    comp[card] = static_cast<int>(4 * numDecks);
+  }
+  comp[10] = static_cast<int>(16 * numDecks);
+  return comp;
+}
+
+DealerProbabilities::DealerProbabilities(const GameRules &rules)
+    : hitsSoft17_(rules.dealerHitsSoft17), infinite_(rules.numDecks == 0),
+      composition_(shoeComposition(rules.numDecks)) {}
+
+DealerProbabilities::DealerProbabilities(const GameRules &rules,
+                                         const Composition &shoe)
+    : hitsSoft17_(rules.dealerHitsSoft17), infinite_(false),
+      composition_(shoe) {}
+
+const DealerOutcomes &DealerProbabilities::get(int upCard) const {
+  if (upCard < 1 || upCard > 10) {
+    throw std::out_of_range("Dealer upcard must be 1-10");
+  }
+  if (fresh_[upCard]) {
+    return current_[upCard];
+  }
+
+  if (infinite_) {
+    current_[upCard] = compute(upCard);
+  } else {
+    auto key = std::make_pair(composition_, upCard);
+    auto it = memo_.find(key);
+    if (it == memo_.end()) {
+      it = memo_.emplace(key, compute(upCard)).first;
+    }
+    current_[upCard] = it->second;
+  }
+  fresh_[upCard] = true;
+  return current_[upCard];
+}
+
+void DealerProbabilities::removeCard(int card) {
+  if (infinite_) {
+    throw std::logic_error("Cannot remove cards from an infinite deck");
+  }
+  if (card < 1 || card > 10 || composition_[card] == 0) {
+    throw std::logic_error("No card of value " + std::to_string(card) +
+                           " left to remove");
+  }
+  --composition_[card];
+  fresh_.fill(false);
+}
+
+void DealerProbabilities::addCard(int card) {
+  if (infinite_) {
+    throw std::logic_error("Cannot add cards to an infinite deck");
+  }
+  if (card < 1 || card > 10) {
+    throw std::logic_error("Card value must be 1-10");
+  }
+  ++composition_[card];
+  fresh_.fill(false);
+}
+
+DealerOutcomes DealerProbabilities::compute(int upCard) const {
+  DealerOutcomes out;
+  Composition comp = composition_;
+  int remaining = 0;
+
+  if (!infinite_) {
+    if (comp[upCard] == 0) {
+      return out; // upcard cannot be dealt from this composition
+    }
+    --comp[upCard];
+    for (int card = 1; card <= 10; ++card) {
+      remaining += comp[card];
+    }
+  }
+
+  dealerRecurse(comp, remaining, infinite_, upCard, upCard == 1, 1, 1.0,
+                upCard, hitsSoft17_, out);
+
+  // Renormalise away rounding (and mass lost to exhausted shoes)
+  double mass = 0.0;
+  for (double p : out.p) {
+    mass += p;
+  }
+  if (mass > 0.0) {
+    for (double &p : out.p) {
+      p /= mass;
+    }
+  }
+  return out;
+}
+
+void DealerProbabilities::precompute() const {
+  for (int upCard = 1; upCard <= 10; ++upCard) {
+    get(upCard);
+  }
+}
+
+const DealerProbabilities &
+DealerProbabilities::forRules(const GameRules &rules) {
+  static std::mutex mutex;
+  static std::map<std::tuple<size_t, bool>,
+                  std::unique_ptr<DealerProbabilities>>
+      cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto key = std::make_tuple(rules.numDecks, rules.dealerHitsSoft17);
+  auto &entry = cache[key];
+  if (!entry) {
+    entry = std::make_unique<DealerProbabilities>(rules);
+    entry->precompute();
+  }
+  return *entry;
+}
+
+} // namespace solver
+} // namespace blackjack
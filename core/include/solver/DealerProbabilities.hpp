@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../game/GameRules.hpp"
+#include <array>
+#include <map>
+#include <utility>
+
+namespace blackjack {
+namespace solver {
+
+/** Remaining cards by blackjack value: [1] = aces, [2]..[9], [10] = tens and
+ *  faces. Index 0 is unused. */
+using Composition = std::array<int, 11>;
+
+/** Full shoe of numDecks 52-card decks. */
+Composition shoeComposition(size_t numDecks);
+
+/** Dealer final-total distribution: p[0..4] = 17..21, p[BUST] = bust. */
+struct DealerOutcomes {
+  static constexpr size_t BUST = 5;
+  std::array<double, 6> p{};
+};
+
+/**
+ * Dealer final-total distributions for every upcard, conditioned on the
+ * dealer not holding blackjack (the engine settles those rounds before the
+ * player acts).
+ *
+ * Finite shoes are solved exactly with card removal; rules.numDecks == 0
+ * means an infinite deck (fixed 1/13 rank odds). The composition is the
+ * unseen shoe before the upcard is dealt: get(up) removes that upcard itself.
+ *
+ * removeCard()/addCard() track a shoe as it is dealt. Upcards are refreshed
+ * lazily on the next get(), and every (composition, upcard) ever solved is
+ * memoised, so revisiting a composition costs a map lookup and repeated
+ * queries on an unchanged composition are O(1) array reads.
+ *
+ * Not thread-safe while mutating; forRules() instances are fully computed up
+ * front and safe to share.
+ */
+class DealerProbabilities {
+public:
+  /** Full shoe for rules.numDecks (0 = infinite deck). */
+  explicit DealerProbabilities(const GameRules &rules);
+
+  /** Arbitrary finite composition. */
+  DealerProbabilities(const GameRules &rules, const Composition &shoe);
+
+  /** upCard: 1 (ace) .. 10. @throws std::out_of_range for other values. */
+  const DealerOutcomes &get(int upCard) const;
+
+  double bustProbability(int upCard) const {
+    return get(upCard).p[DealerOutcomes::BUST];
+  }
+
+  /** @throws std::logic_error on an infinite deck or if none are left. */
+  void removeCard(int card);
+
+  /** @throws std::logic_error on an infinite deck. */
+  void addCard(int card);
+
+  const Composition &getComposition() const { return composition_; }
+  bool isInfinite() const { return infinite_; }
+  bool hitsSoft17() const { return hitsSoft17_; }
+
+  /** Drop memoised compositions (the current one stays valid). */
+  void clearCache() const { memo_.clear(); }
+
+  /** Shared, fully precomputed table for the full shoe of rules. */
+  static const DealerProbabilities &forRules(const GameRules &rules);
+
+private:
+  bool hitsSoft17_;
+  bool infinite_;
+  Composition composition_;
+
+  mutable std::array<DealerOutcomes, 11> current_{};
+  mutable std::array<bool, 11> fresh_{};
+  mutable std::map<std::pair<Composition, int>, DealerOutcomes> memo_;
+
+  DealerOutcomes compute(int upCard) const;
+  void precompute() const;
+};
+
+} // namespace solver
+} // namespace blackjack
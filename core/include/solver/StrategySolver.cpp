@@ -0,0 +1,268 @@
+#include "StrategySolver.hpp"
+#include "../ai/GameStateConverter.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace blackjack {
+namespace solver {
+
+namespace {
+
+/** Hand total after adding a card; total > 21 means bust. */
+void addCard(int total, bool soft, int card, int &newTotal, bool &newSoft) {
+  if (soft) {
+    newTotal = total + card;
+    newSoft = true;
+    if (newTotal > 21) {
+      newTotal -= 10;
+      newSoft = false;
+    }
+  } else if (card == 1 && total + 11 <= 21) {
+    newTotal = total + 11;
+    newSoft = true;
+  } else {
+    newTotal = total + card;
+    newSoft = false;
+  }
+}
+
+} // anonymous namespace
+
+StrategySolver::StrategySolver(const GameRules &rules) : rules_(rules) {
+  solve(DealerProbabilities::forRules(rules));
+}
+
+StrategySolver::StrategySolver(const GameRules &rules, const Composition &shoe)
+    : rules_(rules) {
+  solve(DealerProbabilities(rules, shoe));
+}
+
+void StrategySolver::solve(const DealerProbabilities &dealer) {
+  const Composition &shoe = dealer.getComposition();
+
+  for (int upCard = 1; upCard <= 10; ++upCard) {
+    std::array<double, 11> draw{};
+    if (dealer.isInfinite()) {
+      for (int card = 1; card <= 10; ++card) {
+        draw[card] = (card == 10 ? 4.0 : 1.0) / 13.0;
+      }
+    } else {
+      if (shoe[upCard] == 0) {
+        continue;
+      }
+      Composition comp = shoe;
+      --comp[upCard];
+      int remaining = 0;
+      for (int card = 1; card <= 10; ++card) {
+        remaining += comp[card];
+      }
+      if (remaining == 0) {
+        throw std::invalid_argument("Composition has too few cards to solve");
+      }
+      for (int card = 1; card <= 10; ++card) {
+        draw[card] = static_cast<double>(comp[card]) / remaining;
+      }
+    }
+
+    UpcardSolution &sol = solutions_[upCard];
+    sol.dealer = dealer.get(upCard);
+
+    // Stand: dealer busts or finishes below the player
+    for (int total = 4; total <= 21; ++total) {
+      double ev = sol.dealer.p[DealerOutcomes::BUST];
+      for (int dealer = 17; dealer <= 21; ++dealer) {
+        double p = sol.dealer.p[static_cast<size_t>(dealer - 17)];
+        if (total > dealer) {
+          ev += p;
+        } else if (total < dealer) {
+          ev -= p;
+        }
+      }
+      sol.stand[total] = ev;
+    }
+
+    // Best of HIT/STAND, memoised over (total, soft). Totals only grow except
+    // soft -> hard, and hard never returns to soft above 11, so the
+    // recursion is acyclic.
+    std::array<double, 22> bestHard{}, bestSoft{};
+    std::array<bool, 22> doneHard{}, doneSoft{};
+    auto best = [&](auto &&self, int total, bool soft) -> double {
+      auto &memo = soft ? bestSoft : bestHard;
+      auto &done = soft ? doneSoft : doneHard;
+      if (done[total]) {
+        return memo[total];
+      }
+      double hit = 0.0;
+      for (int card = 1; card <= 10; ++card) {
+        int nt;
+        bool ns;
+        addCard(total, soft, card, nt, ns);
+        hit += draw[card] * (nt > 21 ? -1.0 : self(self, nt, ns));
+      }
+      (soft ? sol.hitSoft : sol.hitHard)[total] = hit;
+      memo[total] = std::max(hit, sol.stand[total]);
+      done[total] = true;
+      return memo[total];
+    };
+
+    for (int total = 4; total <= 21; ++total) {
+      best(best, total, false);
+      if (total >= 12) {
+        best(best, total, true);
+      }
+
+      for (bool soft : {false, true}) {
+        if (soft && total < 12) {
+          continue;
+        }
+        double ev = 0.0;
+        for (int card = 1; card <= 10; ++card) {
+          int nt;
+          bool ns;
+          addCard(total, soft, card, nt, ns);
+          ev += draw[card] * (nt > 21 ? -1.0 : sol.stand[nt]);
+        }
+        (soft ? sol.doubleSoft : sol.doubleHard)[total] = 2.0 * ev;
+      }
+    }
+
+    // Split: each hand is dealt one card, then played on: split aces stand,
+    // other hands hit, stand or (with doubleAfterSplit) double. A pair
+    // dealt again may be resplit while splits remain; hand[r] is one hand's
+    // EV with r resplits left, each resulting hand keeping r - 1 (a slight
+    // overcount of the round's limit, reached only by repeated resplits).
+    const int maxSplits = std::max(0, rules_.maxSplits);
+    std::vector<double> hand(static_cast<size_t>(maxSplits), 0.0);
+    for (int pair = 1; pair <= 10; ++pair) {
+      const bool aces = pair == 1;
+      const bool resplit = !aces || rules_.resplitAces;
+      for (int r = 0; r < maxSplits; ++r) {
+        double ev = 0.0;
+        for (int card = 1; card <= 10; ++card) {
+          int nt;
+          bool ns;
+          addCard(aces ? 11 : pair, aces, card, nt, ns);
+          double play = sol.stand[nt];
+          if (!aces) {
+            play = best(best, nt, ns);
+            if (rules_.doubleAfterSplit) {
+              play = std::max(play, (ns ? sol.doubleSoft : sol.doubleHard)[nt]);
+            }
+          }
+          if (card == pair && resplit && r > 0) {
+            play = std::max(play, 2.0 * hand[static_cast<size_t>(r - 1)]);
+          }
+          ev += draw[card] * play;
+        }
+        hand[static_cast<size_t>(r)] = ev;
+      }
+      sol.split[pair] = maxSplits > 0
+                            ? 2.0 * hand[static_cast<size_t>(maxSplits - 1)]
+                            : std::numeric_limits<double>::lowest();
+    }
+  }
+}
+
+int StrategySolver::pairValue(const ai::State &state) {
+  if (state.hasUsableAce) {
+    return state.playerTotal == 12 ? 1 : 0;
+  }
+  if (state.playerTotal >= 4 && state.playerTotal <= 20 &&
+      state.playerTotal % 2 == 0) {
+    return state.playerTotal / 2;
+  }
+  return 0;
+}
+
+double StrategySolver::expectedValue(const ai::State &state,
+                                     ai::Action action) const {
+  if (!state.isValid()) {
+    throw std::invalid_argument("Cannot solve invalid state " +
+                                state.toString());
+  }
+  const UpcardSolution &sol = solutions_[state.dealerUpCard];
+  const int total = state.playerTotal;
+  const bool soft = state.hasUsableAce;
+
+  switch (action) {
+  case ai::Action::HIT:
+    return soft ? sol.hitSoft[total] : sol.hitHard[total];
+  case ai::Action::STAND:
+    return sol.stand[total];
+  case ai::Action::DOUBLE:
+    return soft ? sol.doubleSoft[total] : sol.doubleHard[total];
+  case ai::Action::SPLIT: {
+    int pair = pairValue(state);
+    return pair ? sol.split[pair] : std::numeric_limits<double>::lowest();
+  }
+  case ai::Action::SURRENDER:
+    return ai::GameStateConverter::outcomeToReward(Outcome::SURRENDER);
+  }
+  return std::numeric_limits<double>::lowest();
+}
+
+ai::ActionMask
+StrategySolver::legalActions(const ai::State &state) const {
+  if (state.isSplitAces()) {
+    return {ai::Action::STAND, ai::Action::SPLIT};
+  }
+  ai::ActionMask actions = ai::ActionMask::base();
+  if (state.canDouble) {
+    actions.insert(ai::Action::DOUBLE);
+  }
+  if (state.canSplit && pairValue(state) != 0 && rules_.maxSplits > 0) {
+    actions.insert(ai::Action::SPLIT);
+  }
+  if (state.canDouble && rules_.surrender) {
+    actions.insert(ai::Action::SURRENDER);
+  }
+  return actions;
+}
+
+ai::Action
+StrategySolver::bestAction(const ai::State &state,
+                           ai::ActionMask validActions) const {
+  if (validActions.empty()) {
+    throw std::invalid_argument("No valid actions provided");
+  }
+  ai::Action bestAction = validActions.front();
+  double bestEv = std::numeric_limits<double>::lowest();
+  for (ai::Action action : validActions) {
+    double ev = expectedValue(state, action);
+    if (ev > bestEv) {
+      bestEv = ev;
+      bestAction = action;
+    }
+  }
+  return bestAction;
+}
+
+ai::PolicyTable StrategySolver::toPolicyTable() const {
+  ai::PolicyTable table;
+
+  for (int upCard = 1; upCard <= 10; ++upCard) {
+    for (bool soft : {false, true}) {
+      for (int total = soft ? 12 : 4; total <= 21; ++total) {
+        for (bool canDouble : {false, true}) {
+          for (bool canSplit : {false, true}) {
+            // Pairs that cannot double are split hands without DAS, or
+            // split aces offered a resplit
+            if (canSplit && pairValue(ai::State(total, upCard, soft)) == 0) {
+              continue;
+            }
+            ai::State state(total, upCard, soft, canSplit, canDouble);
+            for (ai::Action action : legalActions(state)) {
+              table.set(state, action, expectedValue(state, action));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return table;
+}
+
+} // namespace solver
+} // namespace blackjack
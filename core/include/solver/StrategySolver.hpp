@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../ai/Agent.hpp"
+#include "../ai/PolicyTable.hpp"
+#include "../ai/State.hpp"
+#include "../game/GameRules.hpp"
+#include "DealerProbabilities.hpp"
+#include <array>
+#include <vector>
+
+namespace blackjack {
+namespace solver {
+
+/**
+ * Exact expected values (GameStateConverter reward units) for every
+ * (State, Action) the engine can reach under a given GameRules.
+ *
+ * Model:
+ *  - Dealer totals come from DealerProbabilities (exact card removal, no
+ *    dealer blackjack); full shoes share its per-rules cache.
+ *  - Player draws use the same upcard-removed composition, or fixed 1/13
+ *    odds when rules.numDecks == 0 (infinite deck). State keys carry
+ *    totals only, so this is the total-dependent optimum the agent can learn.
+ *  - Actions mirror BlackjackGame: DOUBLE draws one card at 2x stake; SPLIT
+ *    deals each hand one card, after which split aces stand and other
+ *    hands play on (DOUBLE with rules.doubleAfterSplit), a paired card may
+ *    be resplit up to rules.maxSplits (aces with rules.resplitAces), and a
+ *    two-card 21 pays as an ordinary win; SURRENDER (-0.5) is legal wherever
+ *    DOUBLE is when rules.surrender is set.
+ *
+ * Everything is solved per upcard at construction (a few milliseconds);
+ * queries are table lookups.
+ */
+class StrategySolver {
+public:
+  explicit StrategySolver(const GameRules &rules);
+  StrategySolver(const GameRules &rules, const Composition &shoe);
+
+  /** EV of action in state, ignoring the state's flags; lowest() for SPLIT
+   *  when the state is not a pair. */
+  double expectedValue(const ai::State &state, ai::Action action) const;
+
+  /** Actions the engine allows in state under these rules. */
+  ai::ActionMask legalActions(const ai::State &state) const;
+
+  /** Highest-EV action among validActions. */
+  ai::Action bestAction(const ai::State &state,
+                        ai::ActionMask validActions) const;
+
+  /** Highest-EV legal action. */
+  ai::Action bestAction(const ai::State &state) const {
+    return bestAction(state, legalActions(state));
+  }
+
+  /** upCard: 1 (ace) .. 10. */
+  const DealerOutcomes &dealerOutcomes(int upCard) const {
+    return solutions_[upCard].dealer;
+  }
+
+  /** EVs of every legal action in every reachable state, as Q-values. */
+  ai::PolicyTable toPolicyTable() const;
+
+  const GameRules &getRules() const { return rules_; }
+
+private:
+  /** Per-upcard EV tables, indexed by player total (0..21). */
+  struct UpcardSolution {
+    DealerOutcomes dealer;
+    std::array<double, 22> stand{};
+    std::array<double, 22> hitHard{};
+    std::array<double, 22> hitSoft{};
+    std::array<double, 22> doubleHard{};
+    std::array<double, 22> doubleSoft{};
+    std::array<double, 11> split{}; ///< by pair card value
+  };
+
+  GameRules rules_;
+  std::array<UpcardSolution, 11> solutions_;
+
+  void solve(const DealerProbabilities &dealer);
+
+  /** Pair card value the state was dealt (1 = aces), or 0 if not a pair. */
+  static int pairValue(const ai::State &state);
+};
+
+} // namespace solver
+} // namespace blackjack
@@ -21,6 +21,8 @@ ConvergenceReport::ConvergenceReport(double passingThreshold,
 ConvergenceResult ConvergenceReport::analyze(ai::Agent& agent,
                                              const BasicStrategy& basicStrategy) const {
     ConvergenceResult result;
+    result.hasVisitCounts = agent.countsVisits();
+    std::vector<double> chosenVisits;
 
     for (int playerTotal = 4; playerTotal <= 21; ++playerTotal) {
         for (int dealerCard = 1; dealerCard <= 10; ++dealerCard) {
@@ -28,10 +30,13 @@ ConvergenceResult ConvergenceReport::analyze(ai::Agent& agent,
                 ai::State state(playerTotal, dealerCard, soft);
                 if (!state.isValid()) continue;
 
-                std::vector<ai::Action> valid = validActionsForState(state);
+                ai::ActionMask valid =
+                    basicStrategy.validActionsForState(state);
                 ++result.totalStates;
 
                 ai::Action agentAction = agent.chooseAction(state, valid, false);
+                const double visits = agent.getVisitCount(state, agentAction);
+                chosenVisits.push_back(visits);
 
                 if (basicStrategy.isCorrectAction(state, agentAction)) {
                     ++result.matchingStates;
@@ -41,6 +46,8 @@ ConvergenceResult ConvergenceReport::analyze(ai::Agent& agent,
                     div.agentAction   = agentAction;
                     div.optimalAction = basicStrategy.getAction(state);
                     div.qMargin       = computeQMargin(agent, state, valid);
+                    div.visits        = std::min(
+                        visits, agent.getVisitCount(state, div.optimalAction));
                     div.isCritical    = isCriticalState(state);
                     result.divergences.push_back(div);
                 }
@@ -53,6 +60,12 @@ ConvergenceResult ConvergenceReport::analyze(ai::Agent& agent,
         : 0.0;
     result.passed = result.accuracy >= passingThreshold_;
 
+    if (!chosenVisits.empty()) {
+        auto mid = chosenVisits.begin() + chosenVisits.size() / 2;
+        std::nth_element(chosenVisits.begin(), mid, chosenVisits.end());
+        result.medianVisits = *mid;
+    }
+
     // Most confident mistakes first
     std::sort(result.divergences.begin(), result.divergences.end(),
               [](const Divergence& a, const Divergence& b) {
@@ -72,6 +85,10 @@ void ConvergenceReport::print(const ConvergenceResult& result,
         << result.matchingStates << "/" << result.totalStates << " states)\n";
     out << "Threshold         : " << (passingThreshold_ * 100) << "%\n";
     out << "Status            : " << (result.passed ? "PASS ✓" : "FAIL ✗") << "\n";
+    if (result.hasVisitCounts) {
+        out << "Median visits     : " << std::setprecision(0)
+            << result.medianVisits << " (agent's action, all states)\n";
+    }
 
     if (result.divergences.empty()) {
         out << "No divergences from basic strategy.\n";
@@ -94,10 +111,13 @@ void ConvergenceReport::print(const ConvergenceResult& result,
         << std::setw(20) << "State"
         << std::setw(12) << "Agent"
         << std::setw(12) << "Optimal"
-        << std::right << std::setw(10) << "Margin"
-        << std::left  << std::setw(10) << "  Type"
+        << std::right << std::setw(10) << "Margin";
+    if (result.hasVisitCounts) {
+        out << std::setw(10) << "Visits";
+    }
+    out << std::left  << std::setw(10) << "  Type"
         << "\n";
-    out << std::string(64, '-') << "\n";
+    out << std::string(result.hasVisitCounts ? 74 : 64, '-') << "\n";
 
     for (size_t i = 0; i < shown; ++i) {
         const Divergence& d = result.divergences[i];
@@ -110,8 +130,11 @@ void ConvergenceReport::print(const ConvergenceResult& result,
         out << std::left  << std::setw(20) << stateStr
             << std::setw(12) << ai::actionToString(d.agentAction)
             << std::setw(12) << ai::actionToString(d.optimalAction)
-            << std::right << std::fixed << std::setw(9) << std::setprecision(4) << d.qMargin
-            << std::left  << (d.isCritical ? "  CRITICAL" : "  minor")
+            << std::right << std::fixed << std::setw(9) << std::setprecision(4) << d.qMargin;
+        if (result.hasVisitCounts) {
+            out << std::setw(10) << std::setprecision(0) << d.visits;
+        }
+        out << std::left  << (d.isCritical ? "  CRITICAL" : "  minor")
             << "\n";
     }
 
@@ -128,8 +151,11 @@ void ConvergenceReport::print(const ConvergenceResult& result,
             out << "  " << std::left << std::setw(18) << stateStr
                 << " agent=" << std::setw(9) << ai::actionToString(d.agentAction)
                 << " optimal=" << std::setw(9) << ai::actionToString(d.optimalAction)
-                << " margin=" << std::fixed << std::setprecision(4) << d.qMargin
-                << "\n";
+                << " margin=" << std::fixed << std::setprecision(4) << d.qMargin;
+            if (result.hasVisitCounts) {
+                out << " visits=" << std::setprecision(0) << d.visits;
+            }
+            out << "\n";
         }
     }
 
@@ -156,7 +182,7 @@ bool ConvergenceReport::isCriticalState(const ai::State& state) {
 
 double ConvergenceReport::computeQMargin(ai::Agent& agent,
                                          const ai::State& state,
-                                         const std::vector<ai::Action>& validActions) {
+                                         ai::ActionMask validActions) {
     if (validActions.size() < 2) return 0.0;
 
     double top1 = -std::numeric_limits<double>::max();
@@ -169,25 +195,5 @@ double ConvergenceReport::computeQMargin(ai::Agent& agent,
     return (top2 == -std::numeric_limits<double>::max()) ? 0.0 : (top1 - top2);
 }
 
-std::vector<ai::Action> ConvergenceReport::validActionsForState(const ai::State& state) {
-    // Mirrors the logic in Evaluator::compareWithBasicStrategy so the two
-    // accuracy numbers are computed from the same state space.
-    std::vector<ai::Action> valid = {ai::Action::HIT, ai::Action::STAND};
-
-    if (state.playerTotal >= 9 && state.playerTotal <= 11) {
-        valid.push_back(ai::Action::DOUBLE);
-    }
-
-    // Surrender-eligible states (hard 15 vs 10, hard 16 vs 9/10/A)
-    int d = (state.dealerUpCard == 1) ? 11 : state.dealerUpCard;
-    if (!state.hasUsableAce &&
-        ((state.playerTotal == 15 && d == 10) ||
-         (state.playerTotal == 16 && (d == 9 || d == 10 || d == 11)))) {
-        valid.push_back(ai::Action::SURRENDER);
-    }
-
-    return valid;
-}
-
 } // namespace training
 } // namespace blackjack
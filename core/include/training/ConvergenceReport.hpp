@@ -15,6 +15,7 @@ struct Divergence {
     ai::Action  agentAction;   ///< What the agent chose
     ai::Action  optimalAction; ///< What basic strategy prescribes
     double      qMargin;       ///< Q-value gap between best and second-best valid action
+    double      visits;        ///< Updates behind the less-visited of agentAction and optimalAction
     bool        isCritical;    ///< High-frequency / high-stakes state
 };
 
@@ -24,6 +25,8 @@ struct ConvergenceResult {
     bool                 passed         = false;  ///< accuracy >= passing threshold
     size_t               totalStates    = 0;
     size_t               matchingStates = 0;
+    bool                 hasVisitCounts = false;  ///< Agent reports visit counts (Agent::countsVisits)
+    double               medianVisits   = 0.0;    ///< Median visits of the agent's chosen action over all states
     std::vector<Divergence> divergences;          ///< All divergent states, sorted by qMargin desc
 };
 
@@ -33,7 +36,9 @@ struct ConvergenceResult {
  * Iterates all valid (playerTotal 4-21) × (dealerUpCard 1-10) × (soft/hard)
  * states and records every state where the agent disagrees with BasicStrategy.
  * Divergences are ranked by Q-value margin so the most confident mistakes
- * surface first.
+ * surface first. For agents that count visits, each divergence also carries
+ * how often the two disputed actions were updated, so a mistake on a
+ * barely-visited state reads as undertrained rather than mislearned.
  *
  * Usage:
  *   ConvergenceReport report;
@@ -70,10 +75,7 @@ private:
      */
     static double computeQMargin(ai::Agent& agent,
                                  const ai::State& state,
-                                 const std::vector<ai::Action>& validActions);
-
-    /** Build the valid action set for a state, matching compareWithBasicStrategy logic. */
-    static std::vector<ai::Action> validActionsForState(const ai::State& state);
+                                 ai::ActionMask validActions);
 };
 
 } // namespace training
@@ -1,5 +1,8 @@
 #include "Evaluator.hpp"
 #include "../ai/GameStateConverter.hpp"
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 namespace blackjack {
 namespace training {
@@ -105,23 +108,47 @@ void BasicStrategy::initializeSoftStrategy() {
   }
 }
 
-ai::Action BasicStrategy::getAction(const ai::State &state) const {
+BasicStrategy::BasicStrategy(const solver::StrategySolver &solver)
+    : surrender_(solver.getRules().surrender) {
+  const ai::ActionMask noDouble = ai::ActionMask::base();
+  ai::ActionMask twoCard = {ai::Action::HIT, ai::Action::STAND,
+                            ai::Action::DOUBLE};
+  if (surrender_) {
+    twoCard.insert(ai::Action::SURRENDER);
+  }
+
+  for (int dealer = 2; dealer <= 11; ++dealer) {
+    int upCard = (dealer == 11) ? 1 : dealer;
+    for (int player = 4; player <= 21; ++player) {
+      ai::State state(player, upCard, false, false, true);
+      hardStrategy_[{player, dealer}] =
+          Entry(solver.bestAction(state, twoCard),
+                solver.bestAction(state, noDouble));
+    }
+    for (int player = 12; player <= 21; ++player) {
+      ai::State state(player, upCard, true, false, true);
+      softStrategy_[{player, dealer}] =
+          Entry(solver.bestAction(state, twoCard),
+                solver.bestAction(state, noDouble));
+    }
+  }
+}
+
+const BasicStrategy::Entry *
+BasicStrategy::find(const ai::State &state) const {
   int dealerCard = state.dealerUpCard;
   if (dealerCard == 1)
     dealerCard = 11; // Convert ace to 11 for lookup
 
   auto key = std::make_pair(state.playerTotal, dealerCard);
+  const auto &table = state.hasUsableAce ? softStrategy_ : hardStrategy_;
+  auto it = table.find(key);
+  return it != table.end() ? &it->second : nullptr;
+}
 
-  if (state.hasUsableAce) {
-    auto it = softStrategy_.find(key);
-    if (it != softStrategy_.end()) {
-      return it->second;
-    }
-  } else {
-    auto it = hardStrategy_.find(key);
-    if (it != hardStrategy_.end()) {
-      return it->second;
-    }
+ai::Action BasicStrategy::getAction(const ai::State &state) const {
+  if (const Entry *entry = find(state)) {
+    return entry->action;
   }
 
   // Default: hit if < 17, stand if >= 17
@@ -132,57 +159,105 @@ bool BasicStrategy::isCorrectAction(const ai::State &state,
                                     ai::Action action) const {
   ai::Action optimalAction = getAction(state);
 
-  // DOUBLE can be substituted with HIT
-  if (optimalAction == ai::Action::DOUBLE && action == ai::Action::HIT) {
-    return true;
+  // DOUBLE can be substituted with the best non-doubling action
+  if (optimalAction == ai::Action::DOUBLE) {
+    const Entry *entry = find(state);
+    ai::Action fallback = entry ? entry->doubleFallback : ai::Action::HIT;
+    if (action == fallback) {
+      return true;
+    }
   }
 
   return action == optimalAction;
 }
 
+ai::ActionMask
+BasicStrategy::validActionsForState(const ai::State &state) const {
+  ai::ActionMask valid = ai::ActionMask::base();
+  if (state.playerTotal >= 9 && state.playerTotal <= 11) {
+    valid.insert(ai::Action::DOUBLE);
+  }
+  // Offered from the rules, so choosing it where it is wrong scores wrong;
+  // cardCount 0 (untracked) audits as an opening hand
+  if (surrender_ && state.cardCount <= 2) {
+    valid.insert(ai::Action::SURRENDER);
+  }
+  return valid;
+}
+
+// === EvaluationResult ===
+
+void EvaluationResult::record(Outcome outcome, size_t count) {
+  switch (outcome) {
+  case Outcome::PLAYER_WIN:
+  case Outcome::DEALER_BUST:
+    wins += count;
+    break;
+  case Outcome::PLAYER_BLACKJACK:
+    wins += count;
+    blackjacks += count;
+    break;
+  case Outcome::DEALER_WIN:
+    losses += count;
+    break;
+  case Outcome::PLAYER_BUST:
+    losses += count;
+    busts += count;
+    break;
+  case Outcome::PUSH:
+    pushes += count;
+    break;
+  case Outcome::SURRENDER:
+    losses += count;
+    break;
+  }
+}
+
 // === Evaluator Implementation ===
 
-Evaluator::Evaluator(const GameRules &rules) : rules_(rules) {}
+Evaluator::Evaluator(const GameRules &rules, size_t numThreads,
+                     std::optional<uint32_t> seed)
+    : rules_(rules), numThreads_(numThreads), seed_(seed) {
+  if (numThreads_ == 0) {
+    numThreads_ = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
 
 EvaluationResult Evaluator::evaluate(ai::Agent *agent, size_t numGames,
                                      bool compareStrategy) {
   EvaluationResult result;
   result.gamesPlayed = numGames;
 
-  BlackjackGame game(rules_);
+  const size_t numShards = std::max<size_t>(1, std::min(numThreads_, numGames));
   double totalReward = 0.0;
 
-  for (size_t i = 0; i < numGames; ++i) {
-    std::vector<Outcome> outcomes = playGame(agent, game);
-    const std::vector<bool> &wasDoubled = game.getWasDoubledByHand();
+  if (numShards == 1) {
+    totalReward = playShard(agent, numGames, seed_, 0, result);
+  } else {
+    std::vector<EvaluationResult> partials(numShards);
+    std::vector<double> rewards(numShards, 0.0);
+    std::vector<std::thread> threads;
+    threads.reserve(numShards);
+
+    for (size_t shard = 0; shard < numShards; ++shard) {
+      size_t games = numGames / numShards + (shard < numGames % numShards);
+      threads.emplace_back([this, agent, games, shard, &partials,
+                            &rewards]() {
+        rewards[shard] = playShard(agent, games, seed_, shard, partials[shard]);
+      });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
 
-    for (size_t j = 0; j < outcomes.size(); ++j) {
-      Outcome outcome = outcomes[j];
-      bool doubled = j < wasDoubled.size() && wasDoubled[j];
-      switch (outcome) {
-      case Outcome::PLAYER_WIN:
-      case Outcome::DEALER_BUST:
-        result.wins++;
-        break;
-      case Outcome::PLAYER_BLACKJACK:
-        result.wins++;
-        result.blackjacks++;
-        break;
-      case Outcome::DEALER_WIN:
-        result.losses++;
-        break;
-      case Outcome::PLAYER_BUST:
-        result.losses++;
-        result.busts++;
-        break;
-      case Outcome::PUSH:
-        result.pushes++;
-        break;
-      case Outcome::SURRENDER:
-        result.losses++;
-        break;
-      }
-      totalReward += ai::GameStateConverter::outcomeToReward(outcome, doubled);
+    for (size_t shard = 0; shard < numShards; ++shard) {
+      const EvaluationResult &p = partials[shard];
+      result.wins += p.wins;
+      result.losses += p.losses;
+      result.pushes += p.pushes;
+      result.blackjacks += p.blackjacks;
+      result.busts += p.busts;
+      totalReward += rewards[shard];
     }
   }
 
@@ -201,27 +276,34 @@ EvaluationResult Evaluator::evaluate(ai::Agent *agent, size_t numGames,
   return result;
 }
 
-std::vector<Outcome> Evaluator::playGame(ai::Agent *agent, BlackjackGame &game) {
-  game.startRound();
+double Evaluator::playShard(ai::Agent *agent, size_t numGames,
+                            std::optional<uint32_t> seed, uint64_t stream,
+                            EvaluationResult &result) {
+  BlackjackGame game(rules_, seed, stream);
+  double totalReward = 0.0;
 
-  if (game.isRoundComplete()) {
-    return game.getOutcomes();
-  }
+  for (size_t i = 0; i < numGames; ++i) {
+    std::vector<Outcome> outcomes = playGame(agent, game);
+    const std::vector<bool> &wasDoubled = game.getWasDoubledByHand();
 
-  while (!game.isRoundComplete()) {
-    const Hand &playerHand = game.getPlayerHand();
-    const Hand &dealerHand = game.getDealerHand(true);
+    for (size_t j = 0; j < outcomes.size(); ++j) {
+      Outcome outcome = outcomes[j];
+      bool doubled = j < wasDoubled.size() && wasDoubled[j];
+      result.record(outcome);
+      totalReward += ai::GameStateConverter::outcomeToReward(outcome, doubled);
+    }
+  }
 
-    ai::State state = ai::GameStateConverter::toAIState(
-        playerHand, dealerHand, game.canSplit(), game.canDoubleDown());
-    std::vector<ai::Action> validActions =
-        ai::GameStateConverter::getValidActions(
-            playerHand, game.canSplit(), game.canDoubleDown(),
-            game.canSurrender());
+  return totalReward;
+}
 
-    ai::Action action = agent->chooseAction(state, validActions, false);
+std::vector<Outcome> Evaluator::playGame(ai::Agent *agent, BlackjackGame &game) {
+  game.startRound();
 
-    ai::GameStateConverter::executeAction(action, game);
+  for (Observation obs = game.observe(); !obs.done;) {
+    ai::State state = ai::GameStateConverter::toAIState(
+        obs, ai::GameStateConverter::trueCountFor(*agent, game));
+    obs = game.step(agent->chooseAction(state, obs.legalActions, false));
   }
 
   return game.getOutcomes();
@@ -237,19 +319,8 @@ double Evaluator::compareWithBasicStrategy(ai::Agent *agent) {
         ai::State state(playerTotal, dealerCard, hasUsableAce);
         if (!state.isValid()) continue;
 
-        std::vector<ai::Action> validActions = {ai::Action::HIT,
-                                                ai::Action::STAND};
-        if (playerTotal >= 9 && playerTotal <= 11) {
-          validActions.push_back(ai::Action::DOUBLE);
-        }
-        // Surrender-relevant states (two-card hand): hard 15 vs 10, hard 16 vs 9/10/A
-        int dealerForLookup = (dealerCard == 1) ? 11 : dealerCard;
-        if (!hasUsableAce &&
-            ((playerTotal == 15 && dealerForLookup == 10) ||
-             (playerTotal == 16 && (dealerForLookup == 9 || dealerForLookup == 10 ||
-                                    dealerForLookup == 11)))) {
-          validActions.push_back(ai::Action::SURRENDER);
-        }
+        ai::ActionMask validActions =
+            basicStrategy_.validActionsForState(state);
 
         ai::Action agentAction = agent->chooseAction(state, validActions, false);
         if (basicStrategy_.isCorrectAction(state, agentAction)) {
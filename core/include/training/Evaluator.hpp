@@ -3,7 +3,10 @@
 #include "../ai/Agent.hpp"
 #include "../game/BlackjackGame.hpp"
 #include "../game/GameRules.hpp"
+#include "../solver/StrategySolver.hpp"
+#include <cstdint>
 #include <map>
+#include <optional>
 
 namespace blackjack {
 namespace training {
@@ -30,6 +33,11 @@ struct EvaluationResult {
       : gamesPlayed(0), wins(0), losses(0), pushes(0), blackjacks(0), busts(0),
         winRate(0.0), lossRate(0.0), pushRate(0.0), avgReward(0.0),
         bustRate(0.0), strategyAccuracy(0.0) {}
+
+  /**
+   * @brief Count hands with this outcome (rates are filled in separately)
+   */
+  void record(Outcome outcome, size_t count = 1);
 };
 
 /**
@@ -40,8 +48,19 @@ struct EvaluationResult {
  */
 class BasicStrategy {
 public:
+  /**
+   * @brief Published multi-deck chart (rule-independent; late surrender)
+   */
   BasicStrategy();
 
+  /**
+   * @brief Chart derived from exact EVs for the solver's rule set
+   *
+   * Each cell is the best two-card action (HIT/STAND/DOUBLE, plus SURRENDER
+   * when the rules allow it).
+   */
+  explicit BasicStrategy(const solver::StrategySolver &solver);
+
   /**
    * @brief Get optimal action for state
    */
@@ -49,13 +68,37 @@ public:
 
   /**
    * @brief Check if action matches basic strategy
+   *
+   * Where the optimum is DOUBLE, the best non-doubling action also counts.
    */
   bool isCorrectAction(const ai::State &state, ai::Action action) const;
 
+  /**
+   * @brief Actions offered when auditing an agent on state
+   *
+   * HIT/STAND, DOUBLE on totals 9-11, SURRENDER on two-card hands when the
+   * chart's rules allow it (not only where it is correct). Shared by compareWithBasicStrategy, ConvergenceReport and
+   * StrategyChart so all accuracy numbers use the same state space.
+   */
+  ai::ActionMask validActionsForState(const ai::State &state) const;
+
 private:
+  struct Entry {
+    ai::Action action;
+    ai::Action doubleFallback; ///< Accepted in place of DOUBLE
+
+    Entry(ai::Action a = ai::Action::HIT,
+          ai::Action fallback = ai::Action::HIT)
+        : action(a), doubleFallback(fallback) {}
+  };
+
   // Strategy tables: [player total][dealer up card] -> Action
-  std::map<std::pair<int, int>, ai::Action> hardStrategy_;
-  std::map<std::pair<int, int>, ai::Action> softStrategy_;
+  std::map<std::pair<int, int>, Entry> hardStrategy_;
+  std::map<std::pair<int, int>, Entry> softStrategy_;
+  bool surrender_ = true; ///< Rules the chart was built for allow surrender
+
+  /** nullptr if the state is not in the chart. */
+  const Entry *find(const ai::State &state) const;
 
   void initializeHardStrategy();
   void initializeSoftStrategy();
@@ -74,12 +117,22 @@ class Evaluator {
 public:
   /**
    * @brief Construct evaluator with game rules
+   *
+   * @param numThreads Shards games across this many threads (0 = one per core)
+   * @param seed Base seed; shard i always plays RNG stream i of it, so
+   *             repeated evaluations see identical shoes. nullopt = random.
    */
-  explicit Evaluator(const GameRules &rules = GameRules{});
+  explicit Evaluator(const GameRules &rules = GameRules{},
+                     size_t numThreads = 1,
+                     std::optional<uint32_t> seed = std::nullopt);
 
   /**
    * @brief Evaluate agent over multiple games
    *
+   * Games are split into contiguous slices, one per shard, each played on its
+   * own BlackjackGame; counters are summed afterwards. With several threads
+   * the agent's chooseAction(..., training=false) is called concurrently.
+   *
    * @param agent Agent to evaluate
    * @param numGames Number of games to play
    * @param compareStrategy Compare with basic strategy
@@ -103,9 +156,28 @@ public:
    */
   const BasicStrategy &getBasicStrategy() const { return basicStrategy_; }
 
+  /**
+   * @brief Replace the reference strategy (e.g. with a solved one)
+   */
+  void setBasicStrategy(const BasicStrategy &strategy) {
+    basicStrategy_ = strategy;
+  }
+
+  size_t getNumThreads() const { return numThreads_; }
+
 private:
   GameRules rules_;
   BasicStrategy basicStrategy_;
+  size_t numThreads_;
+  std::optional<uint32_t> seed_;
+
+  /**
+   * @brief Play numGames on a fresh game and add counts into result.
+   * @return Summed reward over the slice.
+   */
+  double playShard(ai::Agent *agent, size_t numGames,
+                   std::optional<uint32_t> seed, uint64_t stream,
+                   EvaluationResult &result);
 
   /**
    * @brief Play one evaluation game.
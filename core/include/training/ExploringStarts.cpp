@@ -0,0 +1,84 @@
+#include "ExploringStarts.hpp"
+#include <algorithm>
+#include <random>
+
+namespace blackjack {
+namespace training {
+
+namespace {
+
+Card cardOfValue(int value, Suit suit) {
+  return Card(static_cast<Rank>(value), suit);
+}
+
+} // anonymous namespace
+
+ExploringStarts::ExploringStarts(StartMode mode, const GameRules &rules)
+    : mode_(mode), splitPairs_(rules.maxSplits > 0), cells_(allCells()) {}
+
+std::vector<ExploringStarts::Cell> ExploringStarts::allCells() {
+  std::vector<Cell> cells;
+  cells.reserve(NUM_CELLS);
+  for (int up = 1; up <= 10; ++up) {
+    for (int first = 1; first <= 10; ++first) {
+      for (int second = first; second <= 10; ++second) {
+        if (first == 1 && second == 10) continue; // blackjack
+        cells.push_back({static_cast<uint8_t>(first),
+                         static_cast<uint8_t>(second),
+                         static_cast<uint8_t>(up)});
+      }
+    }
+  }
+  return cells;
+}
+
+ai::State ExploringStarts::cellState(size_t cell) const {
+  const Cell &c = cells_[cell];
+  int total = c.first + c.second;
+  bool soft = c.first == 1 && total + 10 <= 21;
+  if (soft) {
+    total += 10;
+  }
+  ai::State state(total, c.upCard, soft, splitPairs_ && c.first == c.second,
+                  true);
+  state.cardCount = 2;
+  return state;
+}
+
+void ExploringStarts::refresh(const ai::Agent &agent) {
+  if (mode_ != StartMode::COVERAGE || !agent.countsVisits()) {
+    return;
+  }
+  cumulative_.resize(cells_.size());
+  double sum = 0.0;
+  for (size_t i = 0; i < cells_.size(); ++i) {
+    const ai::State state = cellState(i);
+    double visits = 0.0;
+    for (int a = 0; a < 5; ++a) {
+      visits += agent.getVisitCount(state, static_cast<ai::Action>(a));
+    }
+    sum += 1.0 / (1.0 + visits);
+    cumulative_[i] = sum;
+  }
+}
+
+ExploringStarts::Start ExploringStarts::sample(Rng &rng) const {
+  size_t index;
+  if (cumulative_.empty()) {
+    index = boundedRandom(rng, static_cast<uint32_t>(cells_.size()));
+  } else {
+    std::uniform_real_distribution<double> dist(0.0, cumulative_.back());
+    const double target = dist(rng);
+    index = static_cast<size_t>(
+        std::upper_bound(cumulative_.begin(), cumulative_.end(), target) -
+        cumulative_.begin());
+    index = std::min(index, cells_.size() - 1);
+  }
+  const Cell &cell = cells_[index];
+  return {cardOfValue(cell.first, Suit::SPADES),
+          cardOfValue(cell.second, Suit::HEARTS),
+          cardOfValue(cell.upCard, Suit::CLUBS)};
+}
+
+} // namespace training
+} // namespace blackjack
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../ai/Agent.hpp"
+#include "../game/Card.hpp"
+#include "../game/GameRules.hpp"
+#include "../game/Random.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace blackjack {
+namespace training {
+
+/** Where training rounds start. */
+enum class StartMode {
+  NATURAL, ///< Every round is dealt from the shoe
+  UNIFORM, ///< Exploring starts, every start cell equally likely
+  COVERAGE ///< Exploring starts weighted toward the least-learned cells
+};
+
+/**
+ * @brief Exploring-starts sampler: which two cards and upcard a round
+ * begins from
+ *
+ * A start cell is an unordered pair of card values and a dealer upcard
+ * value: 54 two-card hands (blackjack has no decision) × 10 upcards. Dealt
+ * naturally, a pair of eights or a soft 13 vs 2 turns up a few times per
+ * thousand rounds; sampled here, every cell is a few per thousand.
+ * COVERAGE weights each cell by 1 / (1 + N), N being the agent's update
+ * count for the cell's opening state (true count 0), as of the last
+ * refresh().
+ */
+class ExploringStarts {
+public:
+  struct Start {
+    Card first;
+    Card second;
+    Card dealerUpCard;
+  };
+
+  static constexpr size_t NUM_CELLS = 540;
+
+  ExploringStarts(StartMode mode, const GameRules &rules);
+
+  StartMode getMode() const { return mode_; }
+
+  /** Re-weight the cells from agent's visit counts. No-op unless COVERAGE
+   *  and the agent counts visits. */
+  void refresh(const ai::Agent &agent);
+
+  Start sample(Rng &rng) const;
+
+  /** The opening state of a cell, as an agent sees it: two cards, double
+   *  allowed, split allowed on a pair if the rules allow any split (the
+   *  legality BlackjackGame::observe() reports for an unsplit hand). */
+  ai::State cellState(size_t cell) const;
+
+private:
+  struct Cell {
+    uint8_t first;  ///< Card value 1-10, ace = 1
+    uint8_t second; ///< >= first
+    uint8_t upCard;
+  };
+
+  StartMode mode_;
+  bool splitPairs_; ///< rules.maxSplits > 0
+  std::vector<Cell> cells_;
+  /** Running sum of the cell weights; empty = uniform. */
+  std::vector<double> cumulative_;
+
+  static std::vector<Cell> allCells();
+};
+
+} // namespace training
+} // namespace blackjack
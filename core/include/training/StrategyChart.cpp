@@ -38,7 +38,7 @@ char StrategyChart::actionChar(ai::Action action) {
 
 double
 StrategyChart::computeMargin(ai::Agent &agent, const ai::State &state,
-                             const std::vector<ai::Action> &validActions) {
+                             ai::ActionMask validActions) {
   // Same logic as ConvergenceReport::computeQMargin
   if (validActions.size() < 2)
     return 0.0;
@@ -55,22 +55,6 @@ StrategyChart::computeMargin(ai::Agent &agent, const ai::State &state,
   return (top2 < -1e29) ? 0.0 : (top1 - top2);
 }
 
-std::vector<ai::Action>
-StrategyChart::validActionsForState(const ai::State &state) {
-  // Mirror ConvergenceReport::validActionsForState
-  std::vector<ai::Action> valid = {ai::Action::HIT, ai::Action::STAND};
-  if (state.playerTotal >= 9 && state.playerTotal <= 11) {
-    valid.push_back(ai::Action::DOUBLE);
-  }
-  int d = (state.dealerUpCard == 1) ? 11 : state.dealerUpCard;
-  if (!state.hasUsableAce &&
-      ((state.playerTotal == 15 && d == 10) ||
-       (state.playerTotal == 16 && (d == 9 || d == 10 || d == 11)))) {
-    valid.push_back(ai::Action::SURRENDER);
-  }
-  return valid;
-}
-
 void StrategyChart::print(ai::Agent &agent, const BasicStrategy &basicStrategy,
                           std::ostream &out, bool forceNoColor) const {
   bool useColor = !forceNoColor && isTerminal();
@@ -130,7 +114,7 @@ void StrategyChart::printGrid(ai::Agent &agent,
       int dealerCard = dealerCards[i];
       ai::State state(playerTotal, dealerCard, softTotals);
 
-      std::vector<ai::Action> valid = validActionsForState(state);
+      ai::ActionMask valid = basicStrategy.validActionsForState(state);
       ai::Action agentAction = agent.chooseAction(state, valid, false);
       bool matches = basicStrategy.isCorrectAction(state, agentAction);
       double margin = computeMargin(agent, state, valid);
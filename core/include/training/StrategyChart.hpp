@@ -36,10 +36,7 @@ private:
 
   // Compute Q-value margin for coloring
   static double computeMargin(ai::Agent &agent, const ai::State &state,
-                              const std::vector<ai::Action> &validActions);
-
-  // Build valid action set (same as ConvergenceReport::validActionsForState)
-  static std::vector<ai::Action> validActionsForState(const ai::State &state);
+                              ai::ActionMask validActions);
 
   void printGrid(ai::Agent &agent, const BasicStrategy &basicStrategy,
                  bool softTotals, std::ostream &out,
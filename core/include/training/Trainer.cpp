@@ -8,26 +8,125 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <thread>
 
 
 namespace blackjack {
 namespace training {
+
+namespace {
+
+// Salts separating the components seeded from TrainingConfig::seed
+constexpr uint64_t EXPLORATION_SALT = 1;
+constexpr uint64_t EVALUATION_SALT = 2;
+constexpr uint64_t REPLAY_SALT = 3;
+constexpr uint64_t EXPLORING_STARTS_SALT = 4;
+
+// Serial episodes between re-weightings of coverage-driven starts
+constexpr size_t STARTS_REFRESH_INTERVAL = 1000;
+
+std::optional<uint32_t> componentSeed(std::optional<uint32_t> seed,
+                                      uint64_t salt) {
+  if (!seed) return std::nullopt;
+  return deriveSeed(*seed, salt);
+}
+
+} // anonymous namespace
+
 Trainer::Trainer(std::shared_ptr<ai::Agent> agent, const TrainingConfig &config)
     : agent_(agent), config_(config),
-      game_(std::make_unique<BlackjackGame>(config.gameRules)),
-      evaluator_(std::make_unique<Evaluator>(config.gameRules)),
-      logger_(std::make_unique<Logger>(config.logDir)), paused_(false),
+      game_(std::make_unique<BlackjackGame>(config.gameRules, config.seed)),
+      evaluator_(std::make_unique<Evaluator>(
+          config.gameRules, config.evalThreads,
+          componentSeed(config.seed, EVALUATION_SALT))),
+      logger_(std::make_unique<Logger>(config.logDir)),
+      replayRng_(config.seed ? deriveSeed(*config.seed, REPLAY_SALT)
+                             : randomSeed()),
+      startsRng_(config.seed ? deriveSeed(*config.seed, EXPLORING_STARTS_SALT)
+                             : randomSeed()),
+      paused_(false),
       shouldStop_(false), episodesSinceImprovement_(0), bestWinRate_(0.0),
       trainingStartTime_(std::chrono::steady_clock::now()) {
   // Create checkpoint directory if it doesn't exist
   std::filesystem::create_directories(config_.checkpointDir);
   std::filesystem::create_directories(config_.logDir);
 
+  if (config_.solvedReference) {
+    evaluator_->setBasicStrategy(
+        BasicStrategy(solver::StrategySolver(config_.gameRules)));
+  }
+
+  size_t numWorkers = config_.numThreads;
+  if (numWorkers == 0) {
+    numWorkers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (numWorkers > 1 && !agent_->enableConcurrentLearning()) {
+    std::cerr << "Warning: agent '" << agent_->getName()
+              << "' does not support concurrent learning; training on 1 "
+                 "thread.\n";
+    numWorkers = 1;
+  }
+  if (numWorkers > 1) {
+    // Stream 0 is the serial game's; worker i deals from stream 1 + i
+    for (size_t i = 0; i < numWorkers; ++i) {
+      workerGames_.push_back(std::make_unique<BlackjackGame>(
+          config_.gameRules, config_.seed, 1 + i));
+    }
+  }
+  if (config_.seed) {
+    agent_->seed(*componentSeed(config_.seed, EXPLORATION_SALT));
+  }
+  if (config_.replayCapacity > 0) {
+    if (!agent_->supportsReplay()) {
+      std::cerr << "Warning: " << agent_->getName()
+                << " learns from whole episodes; experience replay "
+                   "disabled.\n";
+    } else if (workerGames_.empty()) {
+      replay_ = std::make_unique<ai::ReplayBuffer>(config_.replayCapacity);
+    } else {
+      std::cerr << "Warning: experience replay is serial-only; disabled with "
+                << workerGames_.size() << " threads.\n";
+    }
+  }
+
+  if (config_.exploringStarts != StartMode::NATURAL) {
+    starts_ = std::make_unique<ExploringStarts>(config_.exploringStarts,
+                                                config_.gameRules);
+    if (config_.exploringStarts == StartMode::COVERAGE &&
+        !agent_->countsVisits()) {
+      std::cerr << "Warning: agent '" << agent_->getName()
+                << "' does not count visits; coverage starts sample "
+                   "uniformly.\n";
+    }
+  }
+
   if (config_.verbose) {
     std::cout << "=== Training Configuration ===\n";
     std::cout << "Episodes: " << config_.numEpisodes << "\n";
+    std::cout << "Threads: " << getNumWorkers() << "\n";
+    std::cout << "Reference strategy: "
+              << (config_.solvedReference ? "solved" : "basic chart") << "\n";
+    std::cout << "Experience replay: ";
+    if (replay_) {
+      std::cout << config_.replayBatch << " per episode from "
+                << config_.replayCapacity << " (rare-state priority "
+                << config_.replayRarePriority << ")\n";
+    } else {
+      std::cout << "off\n";
+    }
+    std::cout << "Exploring starts: ";
+    if (starts_) {
+      std::cout << (config_.exploringStarts == StartMode::COVERAGE ? "coverage"
+                                                                  : "uniform")
+                << ", " << config_.exploringStartsFraction * 100
+                << "% of rounds\n";
+    } else {
+      std::cout << "off\n";
+    }
+    std::cout << "Async evaluation: "
+              << (config_.asyncEvaluation ? "on" : "off") << "\n";
     std::cout << "Eval frequency: " << config_.evalFrequency << "\n";
     std::cout << "Checkpoint frequency: " << config_.checkpointFrequency
               << "\n";
@@ -37,6 +136,12 @@ Trainer::Trainer(std::shared_ptr<ai::Agent> agent, const TrainingConfig &config)
   }
 }
 
+Trainer::~Trainer() {
+  if (pendingEval_ && pendingEval_->worker.joinable()) {
+    pendingEval_->worker.join();
+  }
+}
+
 TrainingMetrics Trainer::train() {
   TrainingMetrics metrics = trainEpisodes(config_.numEpisodes);
   runAndSaveReport(metrics);
@@ -54,64 +159,96 @@ TrainingMetrics Trainer::trainEpisodes(size_t numEpisodes) {
   util::ProgressBar progressBar(numEpisodes, 1000);
   if (!config_.verbose) progressBar.setSilent(true);
 
-  // Training loop
-  for (size_t episode = startEpisode; episode < endEpisode; ++episode) {
-    // Check for stop request (signal handler)
-    if (shouldStop_) {
-      if (config_.verbose) {
-        std::cout << "\nStop requested at episode " << (episode + 1)
-                  << ". Saving checkpoint...\n";
+  if (!workerGames_.empty()) {
+    // Parallel: workers run up to the next eval/checkpoint boundary, then the
+    // main thread evaluates and checkpoints with the table quiescent.
+    size_t episode = startEpisode;
+    while (episode < endEpisode) {
+      if (shouldStop_) {
+        if (config_.verbose) {
+          std::cout << "\nStop requested at episode " << (episode + 1)
+                    << ". Saving checkpoint...\n";
+        }
+        saveCheckpoint(episode);
+        break;
       }
-      saveCheckpoint(episode);
-      break;
-    }
 
-    // Check for pause
-    while (paused_) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
+      size_t nextEval = (episode / config_.evalFrequency + 1) *
+                        config_.evalFrequency;
+      size_t nextCheckpoint = (episode / config_.checkpointFrequency + 1) *
+                              config_.checkpointFrequency;
+      size_t segmentEnd = std::min({endEpisode, nextEval, nextCheckpoint});
+
+      size_t completed = runWorkerEpisodes(segmentEnd - episode);
+      episode += completed;
+      currentMetrics_.totalEpisodes = episode;
+      if (episode < segmentEnd) {
+        continue; // interrupted; the stop check above saves a checkpoint
+      }
 
-    // Run episode
-    EpisodeStats stats = runEpisode();
-    stats.episodeNumber = episode + 1;
+      if (!handleEpisodeBoundary(episode)) {
+        break;
+      }
 
-    // Update metrics
-    updateMetrics(stats);
-    currentMetrics_.totalEpisodes = episode + 1;
+      std::string info;
+      if (episode % config_.evalFrequency == 0) {
+        info = "Win: " +
+               std::to_string(static_cast<int>(currentMetrics_.winRate * 100)) +
+               "%" + " | eps: " +
+               std::to_string(currentMetrics_.currentEpsilon).substr(0, 5);
+      }
+      progressBar.update(episode - startEpisode, info);
+    }
+  } else {
+    // Training loop
+    for (size_t episode = startEpisode; episode < endEpisode; ++episode) {
+      // Check for stop request (signal handler)
+      if (shouldStop_) {
+        if (config_.verbose) {
+          std::cout << "\nStop requested at episode " << (episode + 1)
+                    << ". Saving checkpoint...\n";
+        }
+        saveCheckpoint(episode);
+        break;
+      }
 
-    // Periodic evaluation
-    if ((episode + 1) % config_.evalFrequency == 0) {
-      evaluate();
+      // Check for pause
+      while (paused_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
 
-      // Progress callback
-      if (progressCallback_) {
-        progressCallback_(currentMetrics_);
+      if (starts_ && episode % STARTS_REFRESH_INTERVAL == 0) {
+        starts_->refresh(*agent_);
       }
 
-      // Early stopping check
-      if (shouldStopEarly()) {
-        if (config_.verbose) {
-          std::cout << "\nEarly stopping triggered at episode " << (episode + 1)
-                    << "\n";
-        }
+      // Run episode
+      EpisodeStats stats = runEpisode();
+      stats.episodeNumber = episode + 1;
+
+      // Update metrics
+      updateMetrics(stats);
+      currentMetrics_.totalEpisodes = episode + 1;
+
+      // Periodic evaluation and checkpoint
+      if (!handleEpisodeBoundary(episode + 1)) {
         break;
       }
-    }
 
-    // Periodic checkpoint
-    if ((episode + 1) % config_.checkpointFrequency == 0) {
-      saveCheckpoint(episode + 1);
+      // Progress bar update (info only on eval episodes when metrics are fresh)
+      std::string info;
+      if ((episode + 1) % config_.evalFrequency == 0) {
+        info = "Win: " +
+               std::to_string(static_cast<int>(currentMetrics_.winRate * 100)) +
+               "%" + " | eps: " +
+               std::to_string(currentMetrics_.currentEpsilon).substr(0, 5);
+      }
+      progressBar.update(episode + 1 - startEpisode, info);
     }
+  }
 
-    // Progress bar update (info only on eval episodes when metrics are fresh)
-    std::string info;
-    if ((episode + 1) % config_.evalFrequency == 0) {
-      info = "Win: " +
-             std::to_string(static_cast<int>(currentMetrics_.winRate * 100)) +
-             "%" + " | eps: " +
-             std::to_string(currentMetrics_.currentEpsilon).substr(0, 5);
-    }
-    progressBar.update(episode + 1 - startEpisode, info);
+  // Results of an evaluation still running are kept in the history
+  if (pendingEval_) {
+    finishAsyncEvaluation();
   }
 
   // Final evaluation
@@ -135,17 +272,121 @@ TrainingMetrics Trainer::trainEpisodes(size_t numEpisodes) {
   return currentMetrics_;
 }
 
-EpisodeStats Trainer::runEpisode() {
+bool Trainer::handleEpisodeBoundary(size_t episodesDone) {
+  // Deliver a background evaluation as soon as it lands
+  if (pendingEval_ && pendingEval_->done.load(std::memory_order_acquire) &&
+      !finishAsyncEvaluation()) {
+    return false;
+  }
+
+  // Periodic evaluation
+  if (episodesDone % config_.evalFrequency == 0 && config_.asyncEvaluation) {
+    // At most one evaluation in flight: wait for the previous one
+    if (pendingEval_ && !finishAsyncEvaluation()) {
+      return false;
+    }
+    startAsyncEvaluation();
+  } else if (episodesDone % config_.evalFrequency == 0) {
+    evaluate();
+
+    // Progress callback
+    if (progressCallback_) {
+      progressCallback_(currentMetrics_);
+    }
+
+    // Early stopping check
+    if (shouldStopEarly()) {
+      if (config_.verbose) {
+        std::cout << "\nEarly stopping triggered at episode " << episodesDone
+                  << "\n";
+      }
+      return false;
+    }
+  }
+
+  // Periodic checkpoint
+  if (episodesDone % config_.checkpointFrequency == 0) {
+    saveCheckpoint(episodesDone);
+  }
+
+  return true;
+}
+
+size_t Trainer::runWorkerEpisodes(size_t numEpisodes) {
+  const size_t numWorkers = workerGames_.size();
+  std::atomic<size_t> completed{0};
+  std::vector<std::thread> threads;
+  threads.reserve(numWorkers);
+  // Each worker keeps its episodes' stats; they are folded into the metrics
+  // in worker order once the segment is done, as the serial loop does
+  std::vector<std::vector<EpisodeStats>> workerStats(numWorkers);
+
+  const size_t segment = workerSegments_++;
+  if (starts_) {
+    starts_->refresh(*agent_);
+  }
+
+  for (size_t w = 0; w < numWorkers; ++w) {
+    size_t quota = numEpisodes / numWorkers + (w < numEpisodes % numWorkers);
+    if (quota == 0) {
+      continue;
+    }
+    workerStats[w].reserve(quota);
+    threads.emplace_back([this, w, quota, segment, numWorkers, &completed,
+                          &stats = workerStats[w]]() {
+      const uint64_t stream = 1 + segment * numWorkers + w;
+      if (config_.seed) {
+        agent_->seed(*componentSeed(config_.seed, EXPLORATION_SALT), stream);
+      }
+      Rng startsRng(config_.seed
+                        ? deriveSeed(*config_.seed, EXPLORING_STARTS_SALT)
+                        : randomSeed(),
+                    stream);
+      size_t done = 0;
+      for (; done < quota && !shouldStop_; ++done) {
+        while (paused_) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        stats.push_back(runEpisode(*workerGames_[w], startsRng));
+      }
+      completed.fetch_add(done, std::memory_order_relaxed);
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (const auto &stats : workerStats) {
+    for (const EpisodeStats &episode : stats) {
+      updateMetrics(episode);
+    }
+  }
+  return completed.load();
+}
+
+EpisodeStats Trainer::runEpisode() { return runEpisode(*game_, startsRng_); }
+
+void Trainer::startRound(BlackjackGame &game, Rng &startsRng) const {
+  if (starts_ && std::uniform_real_distribution<double>(0.0, 1.0)(startsRng) <
+                     config_.exploringStartsFraction) {
+    const ExploringStarts::Start start = starts_->sample(startsRng);
+    game.startRound(start.first, start.second, start.dealerUpCard);
+  } else {
+    game.startRound();
+  }
+}
+
+EpisodeStats Trainer::runEpisode(BlackjackGame &game, Rng &startsRng) {
   EpisodeStats stats;
   std::vector<ai::Experience> experiences;
 
   // Start new round
-  game_->startRound();
+  startRound(game, startsRng);
 
   // Check for immediate blackjack
-  if (game_->isRoundComplete()) {
-    const std::vector<Outcome> &outcomes = game_->getOutcomes();
-    const std::vector<bool> &wasDoubled = game_->getWasDoubledByHand();
+  if (game.isRoundComplete()) {
+    const std::vector<Outcome> &outcomes = game.getOutcomes();
+    const std::vector<bool> &wasDoubled = game.getWasDoubledByHand();
     finishEpisode(experiences, outcomes, wasDoubled);
     stats.outcome = outcomes.empty() ? Outcome::PUSH : outcomes[0];
     stats.reward = 0.0;
@@ -158,11 +399,11 @@ EpisodeStats Trainer::runEpisode() {
   }
 
   // Play agent's turn
-  playAgentTurn(experiences);
+  playAgentTurn(game, experiences);
 
   // Get outcomes (one per hand; multiple after split)
-  const std::vector<Outcome> &outcomes = game_->getOutcomes();
-  const std::vector<bool> &wasDoubled = game_->getWasDoubledByHand();
+  const std::vector<Outcome> &outcomes = game.getOutcomes();
+  const std::vector<bool> &wasDoubled = game.getWasDoubledByHand();
   stats.outcome = outcomes.empty() ? Outcome::PUSH : outcomes[0];
   stats.reward = 0.0;
   for (size_t i = 0; i < outcomes.size(); ++i) {
@@ -183,37 +424,25 @@ EpisodeStats Trainer::runEpisode() {
   return stats;
 }
 
-void Trainer::playAgentTurn(std::vector<ai::Experience> &experiences) {
-  while (!game_->isRoundComplete()) {
-    const Hand &playerHand = game_->getPlayerHand();
-    const Hand &dealerHand = game_->getDealerHand(true);
-
-    ai::State currentState = ai::GameStateConverter::toAIState(
-        playerHand, dealerHand, game_->canSplit(), game_->canDoubleDown());
-
-    std::vector<ai::Action> validActions =
-        ai::GameStateConverter::getValidActions(
-            playerHand, game_->canSplit(), game_->canDoubleDown(),
-            game_->canSurrender());
-
-    ai::Action action = agent_->chooseAction(currentState, validActions, true);
-
-    ai::GameStateConverter::executeAction(action, *game_);
-
-    ai::State nextState;
-    std::vector<ai::Action> nextValidActions;
-    if (!game_->isRoundComplete()) {
-      nextState = ai::GameStateConverter::toAIState(
-          game_->getPlayerHand(), game_->getDealerHand(true),
-          game_->canSplit(), game_->canDoubleDown());
-      nextValidActions = ai::GameStateConverter::getValidActions(
-          game_->getPlayerHand(), game_->canSplit(), game_->canDoubleDown(),
-          game_->canSurrender());
-    }
-
-    experiences.emplace_back(currentState, action, 0.0, nextState,
-                             game_->isRoundComplete(),
-                             std::move(nextValidActions));
+void Trainer::playAgentTurn(BlackjackGame &game,
+                            std::vector<ai::Experience> &experiences) {
+  // One observation per step; each step's next state is the following
+  // step's state
+  Observation obs = game.observe();
+  ai::State state = ai::GameStateConverter::toAIState(
+      obs, ai::GameStateConverter::trueCountFor(*agent_, game));
+
+  while (!obs.done) {
+    ai::Action action = agent_->chooseAction(state, obs.legalActions, true);
+    obs = game.step(action);
+
+    ai::State nextState =
+        obs.done ? ai::State()
+                 : ai::GameStateConverter::toAIState(
+                       obs, ai::GameStateConverter::trueCountFor(*agent_, game));
+    experiences.emplace_back(state, action, 0.0, nextState, obs.done,
+                             obs.legalActions);
+    state = nextState;
   }
 }
 
@@ -233,6 +462,26 @@ void Trainer::finishEpisode(std::vector<ai::Experience> &experiences,
   for (const auto &exp : experiences) {
     agent_->learn(exp);
   }
+
+  if (replay_) {
+    replay(experiences);
+  }
+}
+
+void Trainer::replay(const std::vector<ai::Experience> &experiences) {
+  const bool prioritized = config_.replayRarePriority != 1.0;
+  for (const auto &exp : experiences) {
+    bool rare = exp.state.hasUsableAce || exp.state.canSplit;
+    replay_->add(exp, rare ? config_.replayRarePriority : 1.0);
+  }
+
+  if (prioritized) {
+    replay_->samplePrioritized(replayRng_, config_.replayBatch,
+                               replaySample_);
+  } else {
+    replay_->sampleUniform(replayRng_, config_.replayBatch, replaySample_);
+  }
+  agent_->learnBatch(replaySample_.data(), replaySample_.size());
 }
 
 void Trainer::updateMetrics(const EpisodeStats &stats) {
@@ -263,31 +512,41 @@ void Trainer::updateMetrics(const EpisodeStats &stats) {
 }
 
 void Trainer::evaluate() {
-  if (config_.verbose) {
-    std::cout << "\n--- Evaluation at episode " << currentMetrics_.totalEpisodes
-              << " ---\n";
-  }
-
   // Run evaluation
   EvaluationResult result =
       evaluator_->evaluate(agent_.get(), config_.evalGames);
 
+  // Get exploration metrics via agent interface
+  recordEvaluation(result, currentMetrics_.totalEpisodes,
+                   agent_->getExplorationRate(), agent_->getStateCount());
+}
+
+TrainingMetrics Trainer::recordEvaluation(const EvaluationResult &result,
+                                          size_t episode,
+                                          double explorationRate,
+                                          size_t statesLearned) {
+  if (config_.verbose) {
+    std::cout << "\n--- Evaluation at episode " << episode << " ---\n";
+  }
+
   // Update metrics
   currentMetrics_.winRate = result.winRate;
   currentMetrics_.lossRate = result.lossRate;
   currentMetrics_.pushRate = result.pushRate;
   currentMetrics_.avgReward = result.avgReward;
   currentMetrics_.bustRate = result.bustRate;
+  currentMetrics_.currentEpsilon = explorationRate;
+  currentMetrics_.statesLearned = statesLearned;
 
-  // Get exploration metrics via agent interface
-  currentMetrics_.currentEpsilon = agent_->getExplorationRate();
-  currentMetrics_.statesLearned = agent_->getStateCount();
+  // Async results describe the policy at snapshot time, not the current one
+  TrainingMetrics evaluated = currentMetrics_;
+  evaluated.totalEpisodes = episode;
 
   // Log metrics
-  logger_->log(currentMetrics_);
+  logger_->log(evaluated);
 
   // Add to history
-  trainingHistory_.push_back(currentMetrics_);
+  trainingHistory_.push_back(evaluated);
 
   // Check for improvement
   if (result.winRate > bestWinRate_ + config_.minImprovement) {
@@ -313,6 +572,53 @@ void Trainer::evaluate() {
     std::cout << "  Episodes since improvement: " << episodesSinceImprovement_
               << "\n";
   }
+
+  return evaluated;
+}
+
+void Trainer::startAsyncEvaluation() {
+  std::unique_ptr<ai::Agent> snapshot = agent_->snapshot();
+  if (!snapshot) {
+    // Agent cannot be copied: evaluate inline instead
+    evaluate();
+    if (progressCallback_) {
+      progressCallback_(currentMetrics_);
+    }
+    return;
+  }
+
+  pendingEval_ = std::make_unique<PendingEvaluation>();
+  PendingEvaluation *pending = pendingEval_.get();
+  pending->snapshot = std::move(snapshot);
+  pending->episode = currentMetrics_.totalEpisodes;
+  pending->worker = std::thread([this, pending]() {
+    pending->result =
+        evaluator_->evaluate(pending->snapshot.get(), config_.evalGames);
+    pending->done.store(true, std::memory_order_release);
+  });
+}
+
+bool Trainer::finishAsyncEvaluation() {
+  std::unique_ptr<PendingEvaluation> pending = std::move(pendingEval_);
+  pending->worker.join();
+
+  TrainingMetrics evaluated = recordEvaluation(
+      pending->result, pending->episode,
+      pending->snapshot->getExplorationRate(),
+      pending->snapshot->getStateCount());
+
+  if (progressCallback_) {
+    progressCallback_(evaluated);
+  }
+
+  if (shouldStopEarly()) {
+    if (config_.verbose) {
+      std::cout << "\nEarly stopping triggered by evaluation at episode "
+                << pending->episode << "\n";
+    }
+    return false;
+  }
+  return true;
 }
 
 void Trainer::saveCheckpoint(size_t episodeNum) {
@@ -369,6 +675,20 @@ void writeSuggestions(const ConvergenceResult &cr, const TrainingMetrics &m,
     any = true;
   }
 
+  if (cr.hasVisitCounts) {
+    size_t undertrained = 0;
+    for (const auto &d : cr.divergences) {
+      if (d.visits < cr.medianVisits / 10) ++undertrained;
+    }
+    if (undertrained > 0) {
+      out << "  • " << undertrained
+          << " divergent state(s) saw under a tenth of the median visits.\n"
+          << "    They are undertrained rather than mislearned: try learning_rate_schedule\n"
+          << "    = polynomial or replay_rare_priority > 1.\n";
+      any = true;
+    }
+  }
+
   if (m.winRate < 0.42) {
     out << "  • Win rate ("
         << std::fixed << std::setprecision(1) << (m.winRate * 100)
@@ -422,7 +742,10 @@ void Trainer::runAndSaveReport(const TrainingMetrics &finalMetrics) {
   oss << std::left << std::setw(24) << "Rules preset"
       << ": " << config_.rulesPresetName   << "\n";
   oss << std::setw(24) << "Num decks"
-      << ": " << config_.gameRules.numDecks << "\n";
+      << ": " << (config_.gameRules.isInfiniteDeck()
+                      ? std::string("infinite")
+                      : std::to_string(config_.gameRules.numDecks))
+      << "\n";
   oss << std::setw(24) << "Dealer hits soft 17"
       << ": " << (config_.gameRules.dealerHitsSoft17 ? "yes" : "no") << "\n";
   oss << std::setw(24) << "Surrender enabled"
@@ -443,6 +766,12 @@ void Trainer::runAndSaveReport(const TrainingMetrics &finalMetrics) {
       << ": " << config_.evalFrequency  << " episodes\n";
   oss << std::setw(24) << "Eval games"
       << ": " << config_.evalGames      << "\n";
+  oss << std::setw(24) << "Reference strategy"
+      << ": " << (config_.solvedReference ? "solved" : "basic chart") << "\n";
+  oss << std::setw(24) << "Eval threads"
+      << ": " << evaluator_->getNumThreads() << "\n";
+  oss << std::setw(24) << "Training threads"
+      << ": " << getNumWorkers()        << "\n";
 
   // 2. Training stats
   oss << "\n--- Training Stats ---\n";
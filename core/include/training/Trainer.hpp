@@ -1,13 +1,17 @@
 #pragma once
 
 #include "../ai/Agent.hpp"
+#include "../ai/ReplayBuffer.hpp"
 #include "../game/BlackjackGame.hpp"
 #include "Evaluator.hpp"
+#include "ExploringStarts.hpp"
 #include "Logger.hpp"
 #include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace blackjack {
@@ -25,6 +29,14 @@ struct TrainingConfig {
   /// Number of games for each evaluation
   size_t evalGames = 1'000;
 
+  /// Threads sharing each evaluation's games (1 = serial, 0 = one per core)
+  size_t evalThreads = 1;
+
+  /// Evaluate a snapshot of the agent on a background thread while training
+  /// continues; results are logged when they land, early stopping uses the
+  /// most recent completed evaluation.
+  bool asyncEvaluation = false;
+
   /// Save checkpoint every N episodes
   size_t checkpointFrequency = 50'000;
 
@@ -46,6 +58,39 @@ struct TrainingConfig {
   /// Minimum improvement to reset patience counter (0.1 = 0.1%)
   double minImprovement = 0.001;
 
+  /// Measure strategy accuracy against the exact solver optimum for
+  /// gameRules instead of the published basic strategy chart
+  bool solvedReference = false;
+
+  /// Worker threads for episode generation (1 = serial, 0 = one per core).
+  /// Each worker owns its own BlackjackGame; the agent's table is shared.
+  size_t numThreads = 1;
+
+  /// Master seed (nullopt = random). Shoes, exploration and evaluation each
+  /// draw independent RNG streams from it: serial runs are reproducible bit
+  /// for bit; with workers, each worker's cards and exploration draws are,
+  /// but the order in which they update the shared table is not.
+  std::optional<uint32_t> seed;
+
+  /// Experience replay: ring capacity in experiences (0 = off). Serial
+  /// training only; ignored with several worker threads.
+  size_t replayCapacity = 0;
+
+  /// Stored experiences re-learned after each episode
+  size_t replayBatch = 32;
+
+  /// Sampling weight of soft-hand and pair states relative to all others
+  /// (1 = uniform); > 1 replays the rare states the chart converges on last
+  double replayRarePriority = 1.0;
+
+  /// Exploring starts: begin rounds from a sampled two-card hand and upcard
+  /// instead of the shoe's deal (NATURAL = off)
+  StartMode exploringStarts = StartMode::NATURAL;
+
+  /// Share of rounds that use an exploring start; the rest are dealt
+  /// naturally so the shoe, count and blackjack payouts stay in play
+  double exploringStartsFraction = 0.5;
+
   // ---- Reporting fields (used by saveTrainingReport) ----
 
   /// Directory for training report output (default: ./analysis)
@@ -113,6 +158,11 @@ public:
    */
   Trainer(std::shared_ptr<ai::Agent> agent, const TrainingConfig &config);
 
+  /**
+   * @brief Waits for any in-flight background evaluation
+   */
+  ~Trainer();
+
   /**
    * @brief Run complete training session
    *
@@ -134,6 +184,13 @@ public:
    */
   EpisodeStats runEpisode();
 
+  /**
+   * @brief Number of threads generating episodes (1 when serial)
+   */
+  size_t getNumWorkers() const {
+    return workerGames_.empty() ? 1 : workerGames_.size();
+  }
+
   /**
    * @brief Get current training metrics
    */
@@ -185,9 +242,24 @@ private:
   std::shared_ptr<ai::Agent> agent_;
   TrainingConfig config_;
   std::unique_ptr<BlackjackGame> game_;
+  /// One game per worker thread; empty in serial mode.
+  std::vector<std::unique_ptr<BlackjackGame>> workerGames_;
+  /// runWorkerEpisodes() calls so far; numbers the workers' exploration
+  /// streams so no two segments replay the same draws.
+  size_t workerSegments_ = 0;
   std::unique_ptr<Evaluator> evaluator_;
   std::unique_ptr<Logger> logger_;
 
+  /// Experience replay (null when off) and its sampling state
+  std::unique_ptr<ai::ReplayBuffer> replay_;
+  Rng replayRng_;
+  std::vector<ai::Experience> replaySample_;
+
+  /// Exploring-starts sampler (null when off); startsRng_ drives the serial
+  /// game's starts, each worker segment seeds its own
+  std::unique_ptr<ExploringStarts> starts_;
+  Rng startsRng_;
+
   TrainingMetrics currentMetrics_;
   std::vector<TrainingMetrics> trainingHistory_;
 
@@ -199,11 +271,43 @@ private:
   double bestWinRate_;
   std::chrono::steady_clock::time_point trainingStartTime_;
 
+  /**
+   * @brief Background evaluation of an agent snapshot (async mode)
+   */
+  struct PendingEvaluation {
+    std::unique_ptr<ai::Agent> snapshot;
+    size_t episode = 0;
+    std::thread worker;
+    std::atomic<bool> done{false};
+    EvaluationResult result;
+  };
+  std::unique_ptr<PendingEvaluation> pendingEval_;
+
   /**
    * @brief Execute evaluation
    */
   void evaluate();
 
+  /**
+   * @brief Fold an evaluation of the policy at `episode` into metrics, log
+   * and history
+   * @return Metrics as of that evaluation
+   */
+  TrainingMetrics recordEvaluation(const EvaluationResult &result,
+                                   size_t episode, double explorationRate,
+                                   size_t statesLearned);
+
+  /**
+   * @brief Snapshot the agent and evaluate it on a background thread
+   */
+  void startAsyncEvaluation();
+
+  /**
+   * @brief Wait for the in-flight evaluation and deliver its results
+   * @return false if early stopping triggered on this result
+   */
+  bool finishAsyncEvaluation();
+
   /**
    * @brief Save checkpoint
    */
@@ -214,10 +318,35 @@ private:
    */
   void updateMetrics(const EpisodeStats &stats);
 
+  /**
+   * @brief Evaluate / checkpoint when episodesDone hits a cadence boundary
+   * @return false if training should stop (early stopping triggered)
+   */
+  bool handleEpisodeBoundary(size_t episodesDone);
+
+  /**
+   * @brief Run numEpisodes split evenly across the worker games
+   * @return Episodes actually completed (fewer if a stop was requested)
+   */
+  size_t runWorkerEpisodes(size_t numEpisodes);
+
+  /**
+   * @brief Run a single training episode on the given game
+   * @param startsRng Draws the exploring start, if any
+   */
+  EpisodeStats runEpisode(BlackjackGame &game, Rng &startsRng);
+
+  /**
+   * @brief Deal the next round: an exploring start with probability
+   * exploringStartsFraction, else from the shoe
+   */
+  void startRound(BlackjackGame &game, Rng &startsRng) const;
+
   /**
    * @brief Play agent's turn in episode
    */
-  void playAgentTurn(std::vector<ai::Experience> &experiences);
+  void playAgentTurn(BlackjackGame &game,
+                     std::vector<ai::Experience> &experiences);
 
   /**
    * @brief Complete episode and learn from experiences
@@ -228,6 +357,11 @@ private:
                     const std::vector<Outcome> &outcomes,
                     const std::vector<bool> &wasDoubledByHand);
 
+  /**
+   * @brief Store an episode's experiences and re-learn a replay sample
+   */
+  void replay(const std::vector<ai::Experience> &experiences);
+
   /**
    * @brief Run exhaustive convergence check against basic strategy, print to
    * stdout (if verbose), and save a full text report to reportDir.
@@ -1,24 +1,172 @@
 #include "ai/QLearningAgent.hpp"
 #include "game/BlackjackGame.hpp"
+#include "solver/StrategySolver.hpp"
+#include "training/Evaluator.hpp"
+#include "training/Trainer.hpp"
 #include "util/ArgParser.hpp"
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <new>
+#include <random>
 
 using namespace blackjack;
 using namespace blackjack::ai;
 using namespace blackjack::util;
 
+// Every global allocation, for the allocations-per-episode benchmark
+static std::atomic<size_t> g_allocations{0};
+
+void *operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+/** Every (state, action) the solver can score, as double-valued EVs. */
+template <typename Table>
+void fillFromSolver(Table &table, const solver::StrategySolver &solver) {
+  for (int up = 1; up <= 10; ++up) {
+    for (int total = 4; total <= 21; ++total) {
+      for (bool soft : {false, true}) {
+        if (soft && total < 12) continue;
+        State state(total, up, soft, false, true);
+        for (Action action : solver.legalActions(state)) {
+          table.set(state, action, solver.expectedValue(state, action));
+        }
+      }
+    }
+  }
+}
+
+/** Fraction of solver states whose stored argmax is still the optimum. */
+template <typename Table>
+double argmaxAgreement(const Table &table,
+                       const solver::StrategySolver &solver) {
+  size_t agree = 0, total = 0;
+  for (int up = 1; up <= 10; ++up) {
+    for (int player = 4; player <= 21; ++player) {
+      for (bool soft : {false, true}) {
+        if (soft && player < 12) continue;
+        State state(player, up, soft, false, true);
+        auto legal = solver.legalActions(state);
+        agree += table.getMaxAction(state, legal) == solver.bestAction(state);
+        ++total;
+      }
+    }
+  }
+  return static_cast<double>(agree) / total;
+}
+
+/** Decision/update throughput, checkpoint size and accuracy for one
+ *  Q-value storage precision. */
+template <typename Table>
+void benchmarkPrecision(const std::string &label, int numOps,
+                        size_t numEpisodes,
+                        const solver::StrategySolver &solver) {
+  using Agent = BasicQLearningAgent<Table>;
+  std::cout << "  [" << label << "]\n";
+  std::cout << "    Row size: " << sizeof(typename Table::Row)
+            << " B, table: " << (sizeof(typename Table::Row) * Table::TABLE_SIZE)
+            << " B\n";
+
+  // Random but valid experiences, shared by the update and decision loops
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<int> totalDist(4, 20), upDist(1, 10);
+  std::vector<Experience> experiences;
+  experiences.reserve(4096);
+  const ActionMask actions = {Action::HIT, Action::STAND, Action::DOUBLE};
+  for (int i = 0; i < 4096; ++i) {
+    State s(totalDist(rng), upDist(rng), false, false, true);
+    State next(std::min(21, s.playerTotal + 1), s.dealerUpCard, false);
+    experiences.emplace_back(s, actions.nth(i % 3), (i % 7) / 7.0 - 0.5, next,
+                             i % 2 == 0, actions);
+  }
+
+  QLearningHyperparameters params;
+  params.epsilon = 0.0;
+  params.epsilonMin = 0.0;
+  auto agent = std::make_unique<Agent>(params);
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int i = 0; i < numOps; ++i) {
+    agent->learn(experiences[static_cast<size_t>(i) & 4095]);
+  }
+  auto mid = std::chrono::high_resolution_clock::now();
+  int checksum = 0;
+  for (int i = 0; i < numOps; ++i) {
+    const Experience &e = experiences[static_cast<size_t>(i) & 4095];
+    checksum += static_cast<int>(agent->chooseAction(e.state, actions, false));
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  double updateSec = std::chrono::duration<double>(mid - start).count();
+  double decideSec = std::chrono::duration<double>(end - mid).count();
+  std::cout << "    Updates:   " << static_cast<long>(numOps / updateSec)
+            << " /s\n";
+  std::cout << "    Decisions: " << static_cast<long>(numOps / decideSec)
+            << " /s (checksum " << checksum << ")\n";
+
+  // Exact EVs stored at this precision
+  auto exact = std::make_unique<Table>();
+  fillFromSolver(*exact, solver);
+  auto path = std::filesystem::temp_directory_path() / "bench_precision.qtable";
+  exact->saveToBinary(path.string());
+  std::cout << "    Solver EVs: " << exact->size() << " states, checkpoint "
+            << std::filesystem::file_size(path) << " B, argmax agreement "
+            << std::fixed << std::setprecision(2)
+            << argmaxAgreement(*exact, solver) * 100 << "%\n";
+  std::filesystem::remove(path);
+
+  // Short Q-learning run at this precision
+  if (numEpisodes > 0) {
+    auto dir = std::filesystem::temp_directory_path() / "blackjack_bench";
+    training::TrainingConfig config;
+    config.gameRules = solver.getRules();
+    config.verbose = false;
+    config.checkpointDir = (dir / "checkpoints").string();
+    config.logDir = (dir / "logs").string();
+
+    QLearningHyperparameters trainParams;
+    trainParams.epsilonDecay = 0.99999;
+    auto learner = std::make_shared<Agent>(trainParams);
+    training::Trainer trainer(learner, config);
+    for (size_t i = 0; i < numEpisodes; ++i) {
+      trainer.runEpisode();
+    }
+    training::Evaluator evaluator(config.gameRules);
+    evaluator.setBasicStrategy(training::BasicStrategy(solver));
+    std::cout << "    After " << numEpisodes << " episodes: accuracy vs optimum "
+              << evaluator.compareWithBasicStrategy(learner.get()) * 100
+              << "%\n";
+    std::filesystem::remove_all(dir);
+  }
+  std::cout << std::defaultfloat;
+}
+
+} // anonymous namespace
+
 int main(int argc, char* argv[]) {
   std::cout << "=== Blackjack Core Engine Benchmark ===\n\n";
 
   ArgParser args("benchmark", "Blackjack Core Engine Benchmark");
   args.addFlag("games", "g", "Games for simulation bench", "100000");
   args.addFlag("decisions", "d", "Decisions for agent bench", "1000000");
+  args.addFlag("episodes", "e", "Training episodes per precision (0 = skip)",
+               "200000");
   args.addBool("help", "h", "Show this help message");
   if (!args.parse(argc, argv)) return 0;
 
   const int NUM_GAMES = args.getInt("games");
   const int NUM_DECISIONS = args.getInt("decisions");
+  const size_t NUM_EPISODES = static_cast<size_t>(args.getInt("episodes"));
 
   // Benchmark 1: Game simulation speed
   {
@@ -59,7 +207,65 @@ int main(int argc, char* argv[]) {
     std::cout << "  Time taken: " << duration.count() << " ms\n";
     std::cout << "  Speed: " << static_cast<int>(gamesPerSecond)
               << " games/second\n";
-    std::cout << "  Win rate: " << winRate << "%\n\n";
+    std::cout << "  Win rate: " << winRate << "%\n";
+
+    // Shoe reshuffles (6 decks) and the same games on a lazily shuffled shoe
+    Deck shoe(6, 1u);
+    const int reshuffles = std::max(1, NUM_GAMES / 10);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < reshuffles; ++i) shoe.shuffle();
+    end = std::chrono::high_resolution_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << "  6-deck reshuffle: " << static_cast<int>(ns / reshuffles)
+              << " ns\n";
+
+    BlackjackGame lazyGame(GameRules{}, std::nullopt, 0, ShuffleMode::LAZY);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_GAMES; ++i) {
+      lazyGame.startRound();
+      while (lazyGame.getPlayerHand().getTotal() < 17 &&
+             !lazyGame.isRoundComplete()) {
+        lazyGame.hit();
+      }
+      if (!lazyGame.isRoundComplete()) lazyGame.stand();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double sec = std::chrono::duration<double>(end - start).count();
+    std::cout << "  Speed, lazy shuffle: " << static_cast<int>(NUM_GAMES / sec)
+              << " games/second\n";
+
+    BlackjackGame countGame(GameRules{}, std::nullopt, 0,
+                            ShuffleMode::RANK_COUNTS);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_GAMES; ++i) {
+      countGame.startRound();
+      while (countGame.getPlayerHand().getTotal() < 17 &&
+             !countGame.isRoundComplete()) {
+        countGame.hit();
+      }
+      if (!countGame.isRoundComplete()) countGame.stand();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    sec = std::chrono::duration<double>(end - start).count();
+    std::cout << "  Speed, rank-count shoe: "
+              << static_cast<int>(NUM_GAMES / sec) << " games/second\n";
+
+    GameRules infiniteRules;
+    infiniteRules.numDecks = 0;
+    BlackjackGame infiniteGame(infiniteRules);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_GAMES; ++i) {
+      infiniteGame.startRound();
+      while (infiniteGame.getPlayerHand().getTotal() < 17 &&
+             !infiniteGame.isRoundComplete()) {
+        infiniteGame.hit();
+      }
+      if (!infiniteGame.isRoundComplete()) infiniteGame.stand();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    sec = std::chrono::duration<double>(end - start).count();
+    std::cout << "  Speed, infinite deck: "
+              << static_cast<int>(NUM_GAMES / sec) << " games/second\n\n";
   }
 
   // Benchmark 2: Q-Learning agent decision speed
@@ -80,7 +286,7 @@ int main(int argc, char* argv[]) {
       }
     }
 
-    std::vector<Action> validActions = {Action::HIT, Action::STAND};
+    const ActionMask validActions = ActionMask::base();
 
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -100,7 +306,87 @@ int main(int argc, char* argv[]) {
     std::cout << "  Time taken: " << duration.count() << " μs\n";
     std::cout << "  Speed: " << static_cast<int>(decisionsPerSecond)
               << " decisions/second\n";
-    std::cout << "  Avg latency: " << avgLatency << " μs/decision\n\n";
+    std::cout << "  Avg latency: " << avgLatency << " μs/decision\n";
+
+    // Masked argmax kernel against its scalar reference, over every mask
+    PolicyTable::Row rows[256];
+    uint8_t masks[256];
+    std::mt19937 rowRng(99);
+    std::uniform_real_distribution<double> qDist(-1.0, 1.0);
+    std::uniform_int_distribution<int> maskDist(1, 31);
+    for (size_t r = 0; r < 256; ++r) {
+      for (double &q : rows[r]) q = qDist(rowRng);
+      masks[r] = static_cast<uint8_t>(maskDist(rowRng));
+    }
+    size_t simdSum = 0, scalarSum = 0;
+    auto kernelStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_DECISIONS; ++i) {
+      simdSum += maskedArgmax(rows[i & 255].data(), masks[(i * 7) & 255]);
+    }
+    auto kernelMid = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < NUM_DECISIONS; ++i) {
+      scalarSum += maskedArgmaxScalar(rows[i & 255].data(),
+                                      masks[(i * 7) & 255]);
+    }
+    auto kernelEnd = std::chrono::high_resolution_clock::now();
+    double simdSec = std::chrono::duration<double>(kernelMid - kernelStart).count();
+    double scalarSec = std::chrono::duration<double>(kernelEnd - kernelMid).count();
+    std::cout << "  Masked argmax: "
+              << static_cast<long>(NUM_DECISIONS / simdSec) << " /s simd, "
+              << static_cast<long>(NUM_DECISIONS / scalarSec)
+              << " /s scalar (checksums " << simdSum << "/" << scalarSum
+              << ")\n\n";
+  }
+
+  // Benchmark 3: Q-value storage precision
+  {
+    std::cout << "Benchmark 3: Q-Value Storage Precision\n";
+    solver::StrategySolver solver(GameRules::vegasStrip());
+    benchmarkPrecision<PolicyTable>("double", NUM_DECISIONS, NUM_EPISODES,
+                                    solver);
+    benchmarkPrecision<FloatPolicyTable>("float", NUM_DECISIONS, NUM_EPISODES,
+                                         solver);
+    benchmarkPrecision<Fixed16PolicyTable>("fixed16", NUM_DECISIONS,
+                                           NUM_EPISODES, solver);
+    std::cout << "\n";
+  }
+
+  // Benchmark 4: heap allocations on the simulation and training hot paths
+  {
+    std::cout << "Benchmark 4: Allocations per Episode\n";
+    const int rounds = std::max(1, NUM_GAMES / 10);
+
+    BlackjackGame game;
+    size_t before = g_allocations.load();
+    for (int i = 0; i < rounds; ++i) {
+      game.startRound();
+      while (game.getPlayerHand().getTotal() < 17 && !game.isRoundComplete()) {
+        game.hit();
+      }
+      if (!game.isRoundComplete()) game.stand();
+    }
+    std::cout << "  Game round (hit to 17): "
+              << static_cast<double>(g_allocations.load() - before) / rounds
+              << " allocations\n";
+
+    auto dir = std::filesystem::temp_directory_path() / "blackjack_bench";
+    training::TrainingConfig config;
+    config.verbose = false;
+    config.checkpointDir = (dir / "checkpoints").string();
+    config.logDir = (dir / "logs").string();
+    training::Trainer trainer(std::make_shared<QLearningAgent>(), config);
+    for (int i = 0; i < 1000; ++i) trainer.runEpisode();  // warm up
+
+    before = g_allocations.load();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < rounds; ++i) trainer.runEpisode();
+    auto end = std::chrono::high_resolution_clock::now();
+    double sec = std::chrono::duration<double>(end - start).count();
+    std::cout << "  Training episode: "
+              << static_cast<double>(g_allocations.load() - before) / rounds
+              << " allocations, " << static_cast<long>(rounds / sec)
+              << " episodes/s\n\n";
+    std::filesystem::remove_all(dir);
   }
 
   std::cout << "=== Benchmark Complete ===\n";
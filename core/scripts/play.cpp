@@ -203,7 +203,7 @@ void displayHand(const std::string &label, const Hand &hand,
 }
 
 /** Prompt the user to choose one of the valid actions; loops until valid. */
-Action getUserAction(const std::vector<Action> &validActions, bool beginnerMode) {
+Action getUserAction(ActionMask validActions, bool beginnerMode) {
     if (beginnerMode) {
         std::cout << color::YELLOW << "\nYour move:" << color::RESET << "\n";
         for (Action a : validActions) {
@@ -223,9 +223,11 @@ Action getUserAction(const std::vector<Action> &validActions, bool beginnerMode)
         std::cout << "Enter choice: ";
     } else {
         std::cout << color::YELLOW << "Action? " << color::RESET << "[";
-        for (size_t i = 0; i < validActions.size(); ++i) {
-            if (i > 0) std::cout << "/";
-            switch (validActions[i]) {
+        const char *sep = "";
+        for (Action a : validActions) {
+            std::cout << sep;
+            sep = "/";
+            switch (a) {
             case Action::HIT:       std::cout << "H"; break;
             case Action::STAND:     std::cout << "S"; break;
             case Action::DOUBLE:    std::cout << "D"; break;
@@ -267,7 +269,7 @@ Action getUserAction(const std::vector<Action> &validActions, bool beginnerMode)
 
 /** Display Q-values for the current state across valid actions (expert mode). */
 void displayQValues(QLearningAgent &agent, const State &state,
-                    const std::vector<Action> &validActions) {
+                    ActionMask validActions) {
     auto qvals = agent.getAllQValues(state);
     std::cout << color::CYAN << "  Q-values: " << color::RESET;
     for (Action a : validActions) {
@@ -280,7 +282,7 @@ void displayQValues(QLearningAgent &agent, const State &state,
 
 /** Compute Q-value margin (top - second) for confidence label. */
 double computeQMargin(QLearningAgent &agent, const State &state,
-                      const std::vector<Action> &validActions) {
+                      ActionMask validActions) {
     if (validActions.size() < 2) return 1.0;
     auto qvals = agent.getAllQValues(state);
     double top1 = -1e30, top2 = -1e30;
@@ -348,7 +350,7 @@ void playHumanMode(BlackjackGame &game, int numHands, bool beginnerMode) {
 
         displayHand("Dealer shows", game.getDealerHand(true), false, beginnerMode);
         if (beginnerMode) {
-            int dealerCard = game.getDealerHand(true).getCards().front().getValue();
+            int dealerCard = game.getDealerUpCard().getValue();
             if (dealerCard >= 7 || dealerCard == 1) {
                 std::cout << color::DIM
                           << "  Dealer's card is strong — tread carefully.\n"
@@ -362,9 +364,7 @@ void playHumanMode(BlackjackGame &game, int numHands, bool beginnerMode) {
         displayHand("Your hand", game.getPlayerHand(), true, beginnerMode);
 
         while (!game.isRoundComplete()) {
-            auto validActions = GameStateConverter::getValidActions(
-                game.getPlayerHand(), game.canSplit(),
-                game.canDoubleDown(), game.canSurrender());
+            ActionMask validActions = game.observe().legalActions;
 
             Action action = getUserAction(validActions, beginnerMode);
             GameStateConverter::executeAction(action, game);
@@ -468,14 +468,13 @@ void playAIMode(BlackjackGame &game, QLearningAgent &agent, int numHands, bool b
 
         while (!game.isRoundComplete()) {
             const Hand &playerHand = game.getPlayerHand();
-            const Hand &dealerHand = game.getDealerHand(true);
 
             displayHand("Player", playerHand, true, beginnerMode);
 
             State state = GameStateConverter::toAIState(
-                playerHand, dealerHand, game.canSplit(), game.canDoubleDown());
-            auto validActions = GameStateConverter::getValidActions(
-                playerHand, game.canSplit(), game.canDoubleDown(), game.canSurrender());
+                playerHand, game.getDealerUpCard(), game.canSplit(),
+                game.canDoubleDown());
+            ActionMask validActions = game.observe().legalActions;
 
             Action action = agent.chooseAction(state, validActions, false);
 
@@ -590,7 +589,7 @@ void playAdvisorMode(BlackjackGame &game, QLearningAgent &agent, int numHands, b
 
         displayHand("Dealer shows", game.getDealerHand(true), false, beginnerMode);
         if (beginnerMode) {
-            int dealerCard = game.getDealerHand(true).getCards().front().getValue();
+            int dealerCard = game.getDealerUpCard().getValue();
             if (dealerCard >= 7 || dealerCard == 1) {
                 std::cout << color::DIM
                           << "  Dealer's card is strong — tread carefully.\n"
@@ -606,11 +605,9 @@ void playAdvisorMode(BlackjackGame &game, QLearningAgent &agent, int numHands, b
             displayHand("Your hand", game.getPlayerHand(), true, beginnerMode);
 
             State state = GameStateConverter::toAIState(
-                game.getPlayerHand(), game.getDealerHand(true),
+                game.getPlayerHand(), game.getDealerUpCard(),
                 game.canSplit(), game.canDoubleDown());
-            auto validActions = GameStateConverter::getValidActions(
-                game.getPlayerHand(), game.canSplit(),
-                game.canDoubleDown(), game.canSurrender());
+            ActionMask validActions = game.observe().legalActions;
 
             Action aiAction = agent.chooseAction(state, validActions, false);
 
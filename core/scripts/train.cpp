@@ -1,3 +1,6 @@
+#include "ai/DoubleQLearningAgent.hpp"
+#include "ai/ExpectedSarsaAgent.hpp"
+#include "ai/MonteCarloAgent.hpp"
 #include "ai/QLearningAgent.hpp"
 #include "game/GameRules.hpp"
 #include "training/Trainer.hpp"
@@ -5,6 +8,7 @@
 #include <algorithm>
 #include <chrono>
 #include <csignal>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include "util/ArgParser.hpp" 
@@ -38,6 +42,45 @@ static GameRules rulesFromPreset(const std::string& preset) {
   return GameRules{};
 }
 
+/** AgentT (BasicQLearningAgent or a subclass) over the table matching
+ *  precision (double, float or fixed16); exportQTable is bound to its CSV
+ *  export.
+ *  @throws std::invalid_argument on an unknown precision. */
+template <template <typename> class AgentT, typename DoubleTable,
+          typename FloatTable, typename Fixed16Table>
+static std::shared_ptr<Agent>
+makeAgent(const std::string &precision,
+          const QLearningHyperparameters &params,
+          std::function<void(const std::string &)> &exportQTable) {
+  auto bind = [&](auto agent) -> std::shared_ptr<Agent> {
+    exportQTable = [agent](const std::string &path) {
+      agent->exportQTable(path);
+    };
+    return agent;
+  };
+  if (precision == "double")
+    return bind(std::make_shared<AgentT<DoubleTable>>(params));
+  if (precision == "float")
+    return bind(std::make_shared<AgentT<FloatTable>>(params));
+  if (precision == "fixed16")
+    return bind(std::make_shared<AgentT<Fixed16Table>>(params));
+  throw std::invalid_argument("unknown q_precision '" + precision +
+                              "' (expected double, float or fixed16)");
+}
+
+/** A double-precision-only agent (Monte Carlo, Double Q); exportQTable is
+ *  bound to its CSV export. */
+template <typename AgentType, typename Params>
+static std::shared_ptr<Agent>
+makeDoubleOnlyAgent(const Params &params,
+                    std::function<void(const std::string &)> &exportQTable) {
+  auto agent = std::make_shared<AgentType>(params);
+  exportQTable = [agent](const std::string &path) {
+    agent->exportQTable(path);
+  };
+  return agent;
+}
+
 int main(int argc, char *argv[]) {
   signal(SIGINT,  signalHandler);
   signal(SIGTERM, signalHandler);
@@ -52,6 +95,15 @@ int main(int argc, char *argv[]) {
   args.addFlag("checkpoint", "c", "Resume from checkpoint file", "");
   args.addFlag("config", "", "Load INI config file", "");
   args.addFlag("rules", "r", "Rule preset name", "vegas-strip");
+  args.addFlag("threads", "t", "Training worker threads, 0 = one per core", "");
+  args.addBool("async-eval", "", "Evaluate on a background thread while training");
+  args.addBool("solved", "", "Score accuracy against the exact optimum for the rules");
+  args.addBool("count", "", "Learn per Hi-Lo true-count bucket");
+  args.addFlag("precision", "", "Q-value storage: double, float or fixed16", "");
+  args.addFlag("agent", "a", "Learning algorithm: q-learning, expected-sarsa, double-q or monte-carlo", "");
+  args.addFlag("seed", "s", "Master RNG seed for a reproducible run", "");
+  args.addFlag("replay", "", "Experience replay capacity, 0 = off", "");
+  args.addFlag("starts", "", "Exploring starts: off, uniform or coverage", "");
   args.addBool("verbose", "v", "Enable verbose output");
   args.addBool("help", "h", "Show this help message");
   if (!args.parse(argc, argv)) return 0;
@@ -85,8 +137,103 @@ int main(int argc, char *argv[]) {
   agentParams.epsilon       = cfg.getDouble("epsilon",        1.0);
   agentParams.epsilonDecay  = cfg.getDouble("epsilon_decay",  0.99995);
   agentParams.epsilonMin    = cfg.getDouble("epsilon_min",    0.01);
+  agentParams.stepExponent  = cfg.getDouble("learning_rate_exponent", 0.8);
+  const std::string schedule = cfg.getString("learning_rate_schedule", "constant");
+  if (schedule == "harmonic") {
+    agentParams.stepSchedule = StepSchedule::HARMONIC;
+  } else if (schedule == "polynomial") {
+    agentParams.stepSchedule = StepSchedule::POLYNOMIAL;
+  } else if (schedule != "constant") {
+    std::cerr << "Error: unknown learning_rate_schedule '" << schedule
+              << "' (expected constant, harmonic or polynomial)\n";
+    return 1;
+  }
+
+  // Exploration strategy and its knobs
+  ExplorationParams &exploration = agentParams.exploration;
+  exploration.ucbConstant          = cfg.getDouble("ucb_constant", 1.0);
+  exploration.stateEpsilonHalfLife = cfg.getDouble("state_epsilon_half_life", 100.0);
+  exploration.temperature          = cfg.getDouble("temperature", 1.0);
+  exploration.temperatureDecay     = cfg.getDouble("temperature_decay", 0.99995);
+  exploration.temperatureMin       = cfg.getDouble("temperature_min", 0.01);
+  const std::string strategy = cfg.getString("exploration", "epsilon-greedy");
+  if (strategy == "state-epsilon") {
+    exploration.strategy = ExplorationStrategy::STATE_EPSILON;
+  } else if (strategy == "ucb") {
+    exploration.strategy = ExplorationStrategy::UCB;
+  } else if (strategy == "boltzmann") {
+    exploration.strategy = ExplorationStrategy::BOLTZMANN;
+  } else if (strategy != "epsilon-greedy") {
+    std::cerr << "Error: unknown exploration '" << strategy
+              << "' (expected epsilon-greedy, state-epsilon, ucb or boltzmann)\n";
+    return 1;
+  }
+
+  // Count-aware agent: CLI flag > config > default
+  bool countAware = cfg.getBool("count_aware", false);
+  if (args.has("count")) countAware = true;
+
+  // Q-value storage precision: CLI > config > default
+  std::string precision = cfg.getString("q_precision", "double");
+  if (args.has("precision")) precision = args.getString("precision");
 
-  auto agent = std::make_shared<QLearningAgent>(agentParams);
+  // Algorithm: CLI > config > default
+  std::string algorithm = cfg.getString("agent", "q-learning");
+  if (args.has("agent")) algorithm = args.getString("agent");
+
+  MonteCarloHyperparameters mcParams;
+  mcParams.learningRate = cfg.getDouble("mc_learning_rate", 0.05);
+  mcParams.firstVisit   = cfg.getBool("mc_first_visit", true);
+  mcParams.epsilon      = agentParams.epsilon;
+  mcParams.epsilonDecay = agentParams.epsilonDecay;
+  mcParams.epsilonMin   = agentParams.epsilonMin;
+
+  std::shared_ptr<Agent> agent;
+  std::function<void(const std::string &)> exportQTable;
+  try {
+    if ((algorithm == "monte-carlo" || algorithm == "double-q") &&
+        precision != "double") {
+      throw std::invalid_argument(algorithm +
+                                  " supports q_precision double only");
+    }
+    if (algorithm == "monte-carlo" &&
+        exploration.strategy != ExplorationStrategy::EPSILON_GREEDY) {
+      throw std::invalid_argument("monte-carlo supports exploration epsilon-greedy only");
+    }
+    if (algorithm == "monte-carlo") {
+      agent = countAware
+                  ? makeDoubleOnlyAgent<CountingMonteCarloAgent>(mcParams, exportQTable)
+                  : makeDoubleOnlyAgent<MonteCarloAgent>(mcParams, exportQTable);
+    } else if (algorithm == "double-q") {
+      agent = countAware
+                  ? makeDoubleOnlyAgent<CountingDoubleQLearningAgent>(agentParams, exportQTable)
+                  : makeDoubleOnlyAgent<DoubleQLearningAgent>(agentParams, exportQTable);
+    } else if (algorithm == "expected-sarsa") {
+      agent = countAware
+                  ? makeAgent<BasicExpectedSarsaAgent, CountingPolicyTable,
+                              FloatCountingPolicyTable,
+                              Fixed16CountingPolicyTable>(precision, agentParams,
+                                                          exportQTable)
+                  : makeAgent<BasicExpectedSarsaAgent, PolicyTable,
+                              FloatPolicyTable, Fixed16PolicyTable>(
+                        precision, agentParams, exportQTable);
+    } else if (algorithm != "q-learning") {
+      throw std::invalid_argument(
+          "unknown agent '" + algorithm +
+          "' (expected q-learning, expected-sarsa, double-q or monte-carlo)");
+    } else if (countAware) {
+      agent = makeAgent<BasicQLearningAgent, CountingPolicyTable,
+                        FloatCountingPolicyTable, Fixed16CountingPolicyTable>(
+          precision, agentParams, exportQTable);
+    } else {
+      agent = makeAgent<BasicQLearningAgent, PolicyTable, FloatPolicyTable,
+                        Fixed16PolicyTable>(precision, agentParams,
+                                            exportQTable);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
+  }
 
   if (!checkpointLoad.empty()) {
     std::cout << "Loading checkpoint: " << checkpointLoad << "\n\n";
@@ -104,12 +251,21 @@ int main(int argc, char *argv[]) {
     gameRules.dealerHitsSoft17 = cfg.getBool("dealer_hits_soft_17");
   if (cfg.has("surrender"))
     gameRules.surrender = cfg.getBool("surrender");
+  if (cfg.has("double_after_split"))
+    gameRules.doubleAfterSplit = cfg.getBool("double_after_split");
+  if (cfg.has("resplit_aces"))
+    gameRules.resplitAces = cfg.getBool("resplit_aces");
+  if (cfg.has("max_splits"))
+    gameRules.maxSplits = cfg.getInt("max_splits");
 
   // --- Training config ---
   TrainingConfig config;
   config.numEpisodes           = numEpisodes;
   config.evalFrequency         = static_cast<size_t>(cfg.getInt("eval_frequency",      10'000));
   config.evalGames             = static_cast<size_t>(cfg.getInt("eval_games",          1'000));
+  config.evalThreads           = static_cast<size_t>(cfg.getInt("eval_threads",        1));
+  config.asyncEvaluation       = cfg.getBool("async_eval", false);
+  if (args.has("async-eval")) config.asyncEvaluation = true;
   config.checkpointFrequency   = static_cast<size_t>(cfg.getInt("checkpoint_frequency",50'000));
   config.checkpointDir         = cfg.getString("checkpoint_dir", "./checkpoints");
   config.logDir                = cfg.getString("log_dir",        "./logs");
@@ -120,11 +276,42 @@ int main(int argc, char *argv[]) {
   config.verbose               = verbose;
   config.earlyStoppingPatience = static_cast<size_t>(cfg.getInt("early_stopping_patience", 10));
   config.minImprovement        = cfg.getDouble("min_improvement", 0.001);
+  config.solvedReference       = cfg.getBool("solved_reference", false);
+  if (args.has("solved")) config.solvedReference = true;
+  // Threads: CLI > config > default
+  config.numThreads            = static_cast<size_t>(cfg.getInt("num_threads", 1));
+  if (args.has("threads")) config.numThreads = std::stoul(args.getString("threads"));
+  // Seed: CLI > config > random
+  if (cfg.has("seed")) config.seed = static_cast<uint32_t>(cfg.getInt("seed"));
+  if (args.has("seed")) config.seed = static_cast<uint32_t>(std::stoul(args.getString("seed")));
+  // Experience replay: CLI > config > off
+  config.replayCapacity        = static_cast<size_t>(cfg.getInt("replay_capacity", 0));
+  if (args.has("replay")) config.replayCapacity = std::stoul(args.getString("replay"));
+  config.replayBatch           = static_cast<size_t>(cfg.getInt("replay_batch", 32));
+  config.replayRarePriority    = cfg.getDouble("replay_rare_priority", 1.0);
+  // Exploring starts: CLI > config > off
+  std::string starts = cfg.getString("exploring_starts", "off");
+  if (args.has("starts")) starts = args.getString("starts");
+  if (starts == "uniform") {
+    config.exploringStarts = StartMode::UNIFORM;
+  } else if (starts == "coverage") {
+    config.exploringStarts = StartMode::COVERAGE;
+  } else if (starts != "off") {
+    std::cerr << "Error: unknown exploring_starts '" << starts
+              << "' (expected off, uniform or coverage)\n";
+    return 1;
+  }
+  config.exploringStartsFraction = cfg.getDouble("exploring_starts_fraction", 0.5);
+  if (config.exploringStartsFraction < 0.0 || config.exploringStartsFraction > 1.0) {
+    std::cerr << "Error: exploring_starts_fraction must be in [0, 1]\n";
+    return 1;
+  }
   config.gameRules             = gameRules;
   // Reporting fields
   config.rulesPresetName       = preset;
-  config.learningRate          = agentParams.learningRate;
-  config.discountFactor        = agentParams.discountFactor;
+  const bool monteCarlo        = algorithm == "monte-carlo";
+  config.learningRate          = monteCarlo ? mcParams.learningRate : agentParams.learningRate;
+  config.discountFactor        = monteCarlo ? mcParams.discountFactor : agentParams.discountFactor;
   config.epsilon               = agentParams.epsilon;
   config.epsilonDecay          = agentParams.epsilonDecay;
   config.epsilonMin            = agentParams.epsilonMin;
@@ -174,7 +361,7 @@ int main(int argc, char *argv[]) {
   agent->save(finalPath);
   std::cout << "Final model saved to: " << finalPath << "\n";
 
-  agent->exportQTable("./analysis/q_table.csv");
+  exportQTable("./analysis/q_table.csv");
   std::cout << "Q-table exported to:  ./analysis/q_table.csv\n";
 
   std::cout << "\nTraining complete. Check logs/ directory for detailed metrics.\n";
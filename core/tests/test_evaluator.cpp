@@ -1,6 +1,9 @@
 #include "ai/QLearningAgent.hpp"
+#include "training/ConvergenceReport.hpp"
 #include "training/Evaluator.hpp"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <random>
 
 using namespace blackjack;
 using namespace blackjack::ai;
@@ -87,6 +90,25 @@ TEST_F(EvaluatorTest, BasicStrategyDoubleSubstitutableByHit) {
   EXPECT_TRUE(bs.isCorrectAction(s, Action::HIT));
 }
 
+TEST(BasicStrategyTest, OffersSurrenderFromTheRules) {
+  GameRules rules;
+  rules.surrender = true;
+  BasicStrategy chart{solver::StrategySolver(rules)};
+  // Offered where it is wrong too, and scored wrong there
+  State hard20(20, 6, false);
+  EXPECT_TRUE(chart.validActionsForState(hard20).contains(Action::SURRENDER));
+  EXPECT_FALSE(chart.isCorrectAction(hard20, Action::SURRENDER));
+  State threeCards = hard20;
+  threeCards.cardCount = 3;
+  EXPECT_FALSE(
+      chart.validActionsForState(threeCards).contains(Action::SURRENDER));
+
+  rules.surrender = false;
+  BasicStrategy noSurrender{solver::StrategySolver(rules)};
+  EXPECT_FALSE(noSurrender.validActionsForState(State(16, 10, false))
+                   .contains(Action::SURRENDER));
+}
+
 // === compareWithBasicStrategy ===
 
 TEST_F(EvaluatorTest, CompareWithBasicStrategyReturnsValidRange) {
@@ -103,3 +125,43 @@ TEST_F(EvaluatorTest, CompareWithBasicStrategyIsDeterministic) {
 
   EXPECT_DOUBLE_EQ(accuracy1, accuracy2);
 }
+
+// === Parallel evaluation ===
+
+TEST_F(EvaluatorTest, ConvergenceReportCarriesVisitCounts) {
+  // Hard 20 vs 10: three wins taught HIT, one push taught STAND
+  State state(20, 10, false);
+  for (int i = 0; i < 3; ++i) {
+    agent->learn(Experience(state, Action::HIT, 1.0, State(), true));
+  }
+  agent->learn(Experience(state, Action::STAND, 0.0, State(), true));
+
+  ConvergenceResult result =
+      ConvergenceReport().analyze(*agent, evaluator.getBasicStrategy());
+  EXPECT_TRUE(result.hasVisitCounts);
+  auto it = std::find_if(result.divergences.begin(), result.divergences.end(),
+                         [&](const Divergence &d) { return d.state == state; });
+  ASSERT_NE(it, result.divergences.end());
+  EXPECT_EQ(it->agentAction, Action::HIT);
+  // The less-visited of the disputed actions
+  EXPECT_EQ(it->visits, 1.0);
+}
+
+TEST_F(EvaluatorTest, ParallelEvaluationCountsSumToGamesPlayed) {
+  Evaluator parallel(GameRules{}, 4, 42u);
+  auto result = parallel.evaluate(agent.get(), 1001, false);
+
+  EXPECT_EQ(result.gamesPlayed, 1001u);
+  EXPECT_EQ(result.wins + result.losses + result.pushes, 1001u);
+}
+
+TEST_F(EvaluatorTest, SeededParallelEvaluationIsDeterministic) {
+  Evaluator a(GameRules{}, 4, 7u);
+  Evaluator b(GameRules{}, 4, 7u);
+  auto r1 = a.evaluate(agent.get(), 2000, false);
+  auto r2 = b.evaluate(agent.get(), 2000, false);
+
+  EXPECT_EQ(r1.wins, r2.wins);
+  EXPECT_EQ(r1.losses, r2.losses);
+  EXPECT_DOUBLE_EQ(r1.avgReward, r2.avgReward);
+}
@@ -1,6 +1,8 @@
 #include "game/BlackjackGame.hpp"
 #include "game/GameRules.hpp"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <map>
 
 using namespace blackjack;
 
@@ -354,6 +356,12 @@ TEST_F(BlackjackGameTest, HideHoleCardShowsOnlyUpcard) {
   EXPECT_EQ(visibleHand.getCards()[0], fullHand.getCards()[0]);
 }
 
+TEST_F(BlackjackGameTest, DealerUpCardIsFirstDealerCard) {
+  EXPECT_THROW(game.getDealerUpCard(), std::logic_error);
+  game.startRound();
+  EXPECT_EQ(game.getDealerUpCard(), game.getDealerHand(false).getCards()[0]);
+}
+
 TEST_F(BlackjackGameTest, HideHoleCardWorksAfterRoundComplete) {
   game.startRound();
   game.stand();
@@ -512,13 +520,18 @@ TEST_F(BlackjackGameTest, CannotSplitAfterHit) {
 }
 
 TEST_F(BlackjackGameTest, SplitCreatesTwoHandsPlayedSequentially) {
+  GameRules rules;
+  rules.maxSplits = 1; // two hands; resplits are covered by ResplitTest
+  BlackjackGame game(rules);
   bool tested = false;
   for (int i = 0; i < 500 && !tested; i++) {
     game.startRound();
     if (!game.isRoundComplete() && game.getPlayerHand().canSplit()) {
+      const bool aces = game.getPlayerHand().getCards()[0].isAce();
       bool ok = game.split();
       ASSERT_TRUE(ok);
-      EXPECT_FALSE(game.isRoundComplete());
+      // Split aces take one card each and settle at once
+      EXPECT_EQ(game.isRoundComplete(), aces);
       // First hand: stand
       game.stand();
       if (!game.isRoundComplete()) {
@@ -535,21 +548,34 @@ TEST_F(BlackjackGameTest, SplitCreatesTwoHandsPlayedSequentially) {
   EXPECT_TRUE(tested);
 }
 
-TEST_F(BlackjackGameTest, CannotSplitTwice) {
+TEST_F(BlackjackGameTest, CannotSplitBeyondMaxSplits) {
+  GameRules rules;
+  rules.maxSplits = 1;
+  BlackjackGame oneSplit(rules, 8u);
   bool tested = false;
   for (int i = 0; i < 500 && !tested; i++) {
-    game.startRound();
-    if (!game.isRoundComplete() && game.getPlayerHand().canSplit()) {
-      EXPECT_TRUE(game.split());
-      EXPECT_FALSE(game.canSplit());
+    oneSplit.startRound();
+    if (!oneSplit.isRoundComplete() && oneSplit.getPlayerHand().canSplit()) {
+      EXPECT_TRUE(oneSplit.split());
+      EXPECT_FALSE(oneSplit.canSplit());
       tested = true;
     }
-    game.reset();
   }
   EXPECT_TRUE(tested);
+
+  rules.maxSplits = 0;
+  BlackjackGame noSplit(rules, 8u);
+  noSplit.startRound(Card(Rank::EIGHT, Suit::SPADES),
+                     Card(Rank::EIGHT, Suit::HEARTS),
+                     Card(Rank::SIX, Suit::CLUBS));
+  EXPECT_FALSE(noSplit.canSplit());
+  EXPECT_FALSE(noSplit.split());
 }
 
 TEST_F(BlackjackGameTest, SplitOutcomesForEachHand) {
+  GameRules rules;
+  rules.maxSplits = 1; // two hands; resplits are covered by ResplitTest
+  BlackjackGame game(rules);
   bool tested = false;
   for (int i = 0; i < 500 && !tested; i++) {
     game.startRound();
@@ -561,9 +587,10 @@ TEST_F(BlackjackGameTest, SplitOutcomesForEachHand) {
       const std::vector<Outcome>& outcomes = game.getOutcomes();
       ASSERT_EQ(outcomes.size(), 2u);
       for (Outcome o : outcomes) {
+        // A split hand's two-card 21 is not a blackjack
         EXPECT_TRUE(o == Outcome::PLAYER_WIN || o == Outcome::DEALER_WIN ||
                     o == Outcome::PUSH || o == Outcome::PLAYER_BUST ||
-                    o == Outcome::DEALER_BUST || o == Outcome::PLAYER_BLACKJACK);
+                    o == Outcome::DEALER_BUST);
       }
       EXPECT_EQ(game.getOutcome(), outcomes[0]);
       tested = true;
@@ -574,6 +601,9 @@ TEST_F(BlackjackGameTest, SplitOutcomesForEachHand) {
 }
 
 TEST_F(BlackjackGameTest, SplitFirstHandBustThenSecondHandPlayed) {
+  GameRules rules;
+  rules.maxSplits = 1; // two hands; resplits are covered by ResplitTest
+  BlackjackGame game(rules);
   // After split: hit until current hand busts (may be first or second hand).
   // When a hand busts we advance to the next; when the last hand is done we get 2 outcomes.
   bool tested = false;
@@ -693,3 +723,485 @@ TEST_F(BlackjackGameTest, SingleDeckPreset) {
   EXPECT_EQ(r.numDecks, 1u);
   EXPECT_TRUE(r.dealerHitsSoft17);
 }
+
+// === Hi-Lo Count Tests ===
+
+TEST_F(BlackjackGameTest, DeckTracksHiLoRunningCount) {
+  Deck deck(1, 7u);
+  int expected = 0;
+  for (int i = 0; i < 20; ++i) {
+    expected += Deck::hiLoTag(deck.deal());
+  }
+  EXPECT_EQ(deck.getRunningCount(), expected);
+  EXPECT_DOUBLE_EQ(deck.getTrueCount(), expected / (32 / 52.0));
+
+  // Hi-Lo is balanced: a fully dealt deck counts back to zero
+  while (deck.cardsRemaining() > 0) {
+    deck.deal();
+  }
+  EXPECT_EQ(deck.getRunningCount(), 0);
+
+  deck.shuffle();
+  EXPECT_EQ(deck.getRunningCount(), 0);
+}
+
+TEST_F(BlackjackGameTest, TrueCountIgnoresHiddenHoleCard) {
+  GameRules rules;
+  rules.numDecks = 1;
+  for (uint32_t seed = 0; seed < 20; ++seed) {
+    BlackjackGame seeded(rules, seed);
+    seeded.startRound();
+    if (seeded.isRoundComplete()) {
+      continue; // hole card already revealed
+    }
+
+    int visible = Deck::hiLoTag(seeded.getDealerHand(true).getCards()[0]);
+    for (const Card &card : seeded.getPlayerHand().getCards()) {
+      visible += Deck::hiLoTag(card);
+    }
+    // Three cards seen; the hole card is still among the 49 unseen
+    EXPECT_DOUBLE_EQ(seeded.getTrueCount(), visible / (49 / 52.0));
+    return;
+  }
+  FAIL() << "No seed produced a round that needs a player decision";
+}
+
+// === RNG Streams ===
+
+TEST(RandomTest, PhiloxMatchesReferenceVectors) {
+  // Random123 known-answer tests for philox4x32_10
+  EXPECT_EQ(Philox4x32::block(0, 0, 0, 0),
+            (std::array<uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c,
+                                     0x9b00dbd8}));
+  EXPECT_EQ(Philox4x32::block(~0ull, ~0ull, 0xffffffff, 0xffffffff),
+            (std::array<uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6,
+                                     0x6d5451fd}));
+  EXPECT_EQ(Philox4x32::block(0x85a308d3243f6a88ull, 0x0370734413198a2eull,
+                              0xa4093822, 0x299f31d0),
+            (std::array<uint32_t, 4>{0xd16cfe09, 0x94fdcceb, 0x5001e420,
+                                     0x24126ea1}));
+}
+
+TEST(RandomTest, DiscardMatchesStepping) {
+  for (uint64_t skip : {0ull, 1ull, 3ull, 4ull, 9ull, 1000ull}) {
+    Rng stepped(42, 3), jumped(42, 3);
+    stepped();
+    jumped();
+    for (uint64_t i = 0; i < skip; ++i) stepped();
+    jumped.discard(skip);
+    EXPECT_EQ(stepped, jumped) << "skip " << skip;
+    EXPECT_EQ(stepped(), jumped()) << "skip " << skip;
+  }
+}
+
+TEST(RandomTest, StreamsOfOneSeedAreDistinct) {
+  Rng a(7, 0), b(7, 1), c(8, 0);
+  int sameAB = 0, sameAC = 0;
+  for (int i = 0; i < 64; ++i) {
+    uint32_t x = a();
+    sameAB += x == b();
+    sameAC += x == c();
+  }
+  EXPECT_EQ(sameAB, 0);
+  EXPECT_EQ(sameAC, 0);
+  EXPECT_NE(deriveSeed(7, 1), deriveSeed(7, 2));
+}
+
+TEST(RandomTest, SeededDecksReplayPerStream) {
+  Deck a(6, 11u, 2), b(6, 11u, 2), other(6, 11u, 3);
+  int differ = 0;
+  for (int i = 0; i < 100; ++i) {
+    Card card = a.deal();
+    EXPECT_EQ(card, b.deal());
+    differ += !(card == other.deal());
+  }
+  EXPECT_GT(differ, 0);
+}
+
+TEST(RandomTest, BoundedRandomStaysInRangeAndIsEven) {
+  Rng rng(3);
+  int counts[6] = {};
+  for (int i = 0; i < 60000; ++i) {
+    uint32_t x = boundedRandom(rng, 6);
+    ASSERT_LT(x, 6u);
+    ++counts[x];
+  }
+  for (int count : counts) {
+    EXPECT_NEAR(count, 10000, 500);
+  }
+  EXPECT_EQ(boundedRandom(rng, 1), 0u);
+}
+
+TEST(RandomTest, BatchedShuffleHitsEveryPermutationEvenly) {
+  // 5 elements: one batched triple, then one single draw
+  Rng rng(17);
+  std::map<std::array<int, 5>, int> counts;
+  for (int i = 0; i < 120000; ++i) {
+    std::array<int, 5> items = {0, 1, 2, 3, 4};
+    fisherYatesShuffle(items.begin(), items.size(), rng);
+    ++counts[items];
+  }
+  ASSERT_EQ(counts.size(), 120u);
+  for (const auto &entry : counts) {
+    EXPECT_NEAR(entry.second, 1000, 150);
+  }
+}
+
+// === Shuffle Modes ===
+
+namespace {
+
+/** Deal the whole shoe; every (rank, suit) must appear numDecks times. */
+void expectFullShoe(Deck &deck, size_t numDecks) {
+  int seen[14][4] = {};
+  while (deck.cardsRemaining() > 0) {
+    Card card = deck.deal();
+    ++seen[static_cast<int>(card.getRank())][static_cast<int>(card.getSuit())];
+  }
+  for (int rank = 1; rank <= 13; ++rank) {
+    for (int suit = 0; suit < 4; ++suit) {
+      EXPECT_EQ(seen[rank][suit], static_cast<int>(numDecks));
+    }
+  }
+  EXPECT_EQ(deck.getRunningCount(), 0);
+}
+
+} // namespace
+
+TEST(DeckShuffleTest, ReshuffleKeepsEveryCard) {
+  for (ShuffleMode mode : {ShuffleMode::UPFRONT, ShuffleMode::LAZY}) {
+    Deck deck(2, 5u, 0, mode);
+    for (int i = 0; i < 30; ++i) deck.deal();
+    deck.reset();
+    EXPECT_EQ(deck.cardsRemaining(), 104u);
+    expectFullShoe(deck, 2);
+
+    deck.shuffle();
+    expectFullShoe(deck, 2);
+  }
+}
+
+TEST(DeckShuffleTest, LazyDeckIsReproducibleAndShuffled) {
+  Deck a(1, 9u, 0, ShuffleMode::LAZY), b(1, 9u, 0, ShuffleMode::LAZY);
+  EXPECT_EQ(a.getShuffleMode(), ShuffleMode::LAZY);
+  int inOrder = 0;
+  for (int i = 0; i < 52; ++i) {
+    Card card = a.deal();
+    EXPECT_EQ(card, b.deal());
+    inOrder += card.getRank() == static_cast<Rank>(i % 13 + 1);
+  }
+  EXPECT_LT(inOrder, 20);
+}
+
+TEST(DeckShuffleTest, LazyFirstCardIsUniform) {
+  // Each of 52 cards should lead about 1/52 of fresh lazy shoes
+  int counts[52] = {};
+  Deck deck(1, 21u, 0, ShuffleMode::LAZY);
+  for (int i = 0; i < 52000; ++i) {
+    deck.shuffle();
+    Card card = deck.deal();
+    ++counts[static_cast<int>(card.getSuit()) * 13 +
+             static_cast<int>(card.getRank()) - 1];
+  }
+  for (int count : counts) {
+    EXPECT_NEAR(count, 1000, 150);
+  }
+}
+
+TEST(InfiniteDeckTest, DrawsUniformlyAndNeverRunsOut) {
+  Deck deck(0, 13u);
+  EXPECT_TRUE(deck.isInfinite());
+  EXPECT_EQ(deck.totalCards(), 0u);
+  int counts[52] = {};
+  for (int i = 0; i < 52000; ++i) {
+    Card card = deck.deal();
+    ++counts[static_cast<int>(card.getSuit()) * 13 +
+             static_cast<int>(card.getRank()) - 1];
+  }
+  for (int count : counts) {
+    EXPECT_NEAR(count, 1000, 150);
+  }
+  EXPECT_FALSE(deck.needsReshuffle(1.0));
+  EXPECT_EQ(deck.getRunningCount(), 0);
+  EXPECT_EQ(deck.getTrueCount(), 0.0);
+  EXPECT_THROW(deck.needsReshuffle(1.5), std::invalid_argument);
+
+  Deck replay(0, 13u);
+  Deck same(0, 13u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(replay.deal(), same.deal());
+  }
+}
+
+TEST(InfiniteDeckTest, GamePlaysWithoutCount) {
+  GameRules rules;
+  rules.numDecks = 0;
+  EXPECT_TRUE(rules.isInfiniteDeck());
+  BlackjackGame game(rules, 3u);
+  for (int round = 0; round < 2000; ++round) {
+    game.startRound();
+    EXPECT_EQ(game.getTrueCount(), 0.0);
+    while (!game.isRoundComplete()) {
+      if (game.getPlayerHand().getTotal() < 17) {
+        game.hit();
+      } else {
+        game.stand();
+      }
+    }
+    EXPECT_EQ(game.getTrueCount(), 0.0);
+  }
+}
+
+TEST(RankCountShoeTest, DealsExactCompositionWithoutCards) {
+  Deck deck(2, 4u, 0, ShuffleMode::RANK_COUNTS);
+  EXPECT_EQ(deck.totalCards(), 104u);
+  int seen[11] = {};
+  int runningCount = 0;
+  for (int i = 0; i < 104; ++i) {
+    Card card = deck.deal();
+    ++seen[card.getValue()];
+    runningCount += Deck::hiLoTag(card);
+    EXPECT_EQ(deck.cardsRemaining(), 103u - i);
+  }
+  for (int value = 1; value <= 9; ++value) {
+    EXPECT_EQ(seen[value], 8) << "value " << value;
+  }
+  EXPECT_EQ(seen[10], 32);
+  EXPECT_EQ(deck.getRunningCount(), runningCount);
+  EXPECT_EQ(deck.getRunningCount(), 0);
+  EXPECT_THROW(deck.deal(), std::runtime_error);
+
+  deck.reset();
+  EXPECT_EQ(deck.cardsRemaining(), 104u);
+  EXPECT_EQ(deck.remainingOfValue(10), 32u);
+}
+
+TEST(RankCountShoeTest, TracksEachTenRank) {
+  Deck deck(1, 7u, 0, ShuffleMode::RANK_COUNTS);
+  int seen[14] = {};
+  for (int i = 0; i < 52; ++i) {
+    ++seen[static_cast<int>(deck.deal().getRank())];
+  }
+  for (int rank = 1; rank <= 13; ++rank) {
+    EXPECT_EQ(seen[rank], 4) << "rank " << rank;
+  }
+}
+
+TEST(RankCountShoeTest, CompositionTracksDealsInEveryMode) {
+  for (ShuffleMode mode : {ShuffleMode::UPFRONT, ShuffleMode::LAZY,
+                           ShuffleMode::RANK_COUNTS}) {
+    Deck deck(6, 8u, 0, mode);
+    int dealt[11] = {};
+    for (int i = 0; i < 150; ++i) {
+      ++dealt[deck.deal().getValue()];
+    }
+    size_t total = 0;
+    for (int value = 1; value <= 10; ++value) {
+      uint32_t full = value == 10 ? 96 : 24;
+      EXPECT_EQ(deck.remainingOfValue(value), full - dealt[value]);
+      total += deck.getComposition()[value - 1];
+    }
+    EXPECT_EQ(total, deck.cardsRemaining());
+  }
+  EXPECT_THROW(Deck().remainingOfValue(11), std::out_of_range);
+  EXPECT_EQ(Deck(0).remainingOfValue(10), 16u);
+}
+
+TEST(RankCountShoeTest, FirstCardFollowsComposition) {
+  // Tens should lead about 4/13 of fresh shoes, every other value 1/13
+  int counts[11] = {};
+  Deck deck(1, 6u, 0, ShuffleMode::RANK_COUNTS);
+  for (int i = 0; i < 13000; ++i) {
+    deck.shuffle();
+    ++counts[deck.deal().getValue()];
+  }
+  for (int value = 1; value <= 9; ++value) {
+    EXPECT_NEAR(counts[value], 1000, 150);
+  }
+  EXPECT_NEAR(counts[10], 4000, 300);
+}
+
+TEST(ObservationTest, MatchesAccessorsThroughRandomPlay) {
+  GameRules rules;
+  rules.surrender = true;
+  BlackjackGame game(rules, 31u);
+  Rng rng(7u);
+  for (int round = 0; round < 3000; ++round) {
+    game.startRound();
+    Observation obs = game.observe();
+    while (!obs.done) {
+      const Hand &hand = game.getPlayerHand();
+      EXPECT_EQ(obs.playerTotal, hand.getTotal());
+      EXPECT_EQ(obs.soft, hand.isSoft());
+      EXPECT_EQ(obs.cardCount, hand.size());
+      EXPECT_EQ(obs.dealerUpCard, game.getDealerUpCard().getValue());
+      EXPECT_EQ(obs.legalActions.contains(Action::DOUBLE),
+                game.canDoubleDown());
+      EXPECT_EQ(obs.legalActions.contains(Action::SPLIT), game.canSplit());
+      EXPECT_EQ(obs.legalActions.contains(Action::SURRENDER),
+                game.canSurrender());
+      EXPECT_TRUE(obs.legalActions.contains(Action::HIT));
+      EXPECT_TRUE(obs.legalActions.contains(Action::STAND));
+
+      Action action = obs.legalActions.nth(
+          boundedRandom(rng, static_cast<uint32_t>(obs.legalActions.size())));
+      obs = game.step(action);
+      EXPECT_EQ(obs.done, game.isRoundComplete());
+    }
+    EXPECT_TRUE(obs.legalActions.empty());
+    EXPECT_EQ(obs.playerTotal, 0);
+  }
+}
+
+TEST(ObservationTest, IllegalDoubleHitsAndIllegalSplitIsIgnored) {
+  BlackjackGame game(GameRules{}, 2u);
+  Observation obs;
+  // A live three-card hand: no split, no double
+  do {
+    game.startRound();
+    if (!game.isRoundComplete()) game.hit();
+    obs = game.observe();
+  } while (obs.done);
+  ASSERT_EQ(obs.cardCount, 3);
+  EXPECT_EQ(obs.legalActions, ActionMask::base());
+
+  Observation same = game.step(Action::SPLIT);
+  EXPECT_EQ(same.playerTotal, obs.playerTotal);
+  EXPECT_EQ(same.cardCount, obs.cardCount);
+  EXPECT_FALSE(same.done);
+
+  Observation after = game.step(Action::DOUBLE);
+  EXPECT_FALSE(game.getWasDoubledByHand()[0]);
+  EXPECT_EQ(game.getPlayerHand().size(), 4u);
+  EXPECT_EQ(after.done, game.isRoundComplete());
+}
+
+TEST(ExploringStartTest, RoundStartsFromGivenCards) {
+  BlackjackGame game(GameRules{}, 5u);
+
+  game.startRound(Card(Rank::EIGHT, Suit::SPADES),
+                  Card(Rank::EIGHT, Suit::HEARTS),
+                  Card(Rank::SIX, Suit::CLUBS));
+  Observation obs = game.observe();
+  ASSERT_FALSE(obs.done);
+  EXPECT_EQ(obs.playerTotal, 16);
+  EXPECT_FALSE(obs.soft);
+  EXPECT_EQ(obs.cardCount, 2);
+  EXPECT_EQ(obs.dealerUpCard, 6);
+  EXPECT_TRUE(obs.legalActions.contains(Action::SPLIT));
+  EXPECT_TRUE(obs.legalActions.contains(Action::DOUBLE));
+  EXPECT_EQ(game.getDealerHand().size(), 2u);
+
+  // The rest of the round plays normally
+  obs = game.step(Action::STAND);
+  EXPECT_TRUE(obs.done);
+  EXPECT_EQ(game.getOutcomes().size(), 1u);
+
+  game.startRound(Card(Rank::ACE, Suit::SPADES),
+                  Card(Rank::SEVEN, Suit::HEARTS),
+                  Card(Rank::TEN, Suit::CLUBS));
+  obs = game.observe();
+  EXPECT_EQ(obs.playerTotal, 18);
+  EXPECT_TRUE(obs.soft);
+  EXPECT_FALSE(obs.legalActions.contains(Action::SPLIT));
+}
+
+TEST(ExploringStartTest, GivenBlackjackSettlesImmediately) {
+  BlackjackGame game(GameRules{}, 5u);
+  // A 5 upcard cannot be a dealer blackjack
+  game.startRound(Card(Rank::ACE, Suit::SPADES),
+                  Card(Rank::KING, Suit::HEARTS),
+                  Card(Rank::FIVE, Suit::CLUBS));
+  EXPECT_TRUE(game.isRoundComplete());
+  ASSERT_EQ(game.getOutcomes().size(), 1u);
+  EXPECT_EQ(game.getOutcomes()[0], Outcome::PLAYER_BLACKJACK);
+}
+
+// === Resplit, double after split and split aces ===
+
+namespace {
+
+Card cardOf(Rank rank) { return Card(rank, Suit::SPADES); }
+
+} // namespace
+
+TEST(ResplitTest, ResplitsUpToMaxSplits) {
+  GameRules rules;
+  rules.maxSplits = 3;
+  BlackjackGame game(rules, 21u);
+  size_t mostHands = 0;
+  for (int i = 0; i < 3000; ++i) {
+    game.startRound(cardOf(Rank::EIGHT), cardOf(Rank::EIGHT),
+                    cardOf(Rank::SIX));
+    while (!game.isRoundComplete()) {
+      if (game.canSplit()) {
+        ASSERT_TRUE(game.split());
+      } else {
+        game.stand();
+      }
+    }
+    ASSERT_LE(game.getNumHands(), 4u);
+    EXPECT_EQ(game.getOutcomes().size(), game.getNumHands());
+    EXPECT_EQ(game.getWasDoubledByHand().size(), game.getNumHands());
+    mostHands = std::max(mostHands, game.getNumHands());
+  }
+  EXPECT_EQ(mostHands, 4u);
+}
+
+TEST(ResplitTest, DoubleAfterSplitFollowsRules) {
+  for (bool das : {false, true}) {
+    GameRules rules;
+    rules.doubleAfterSplit = das;
+    BlackjackGame game(rules, 4u);
+    game.startRound(cardOf(Rank::NINE), cardOf(Rank::NINE), cardOf(Rank::FIVE));
+    ASSERT_TRUE(game.split());
+    EXPECT_EQ(game.canDoubleDown(), das);
+    EXPECT_EQ(game.observe().legalActions.contains(Action::DOUBLE), das);
+    EXPECT_FALSE(game.canSurrender());
+    if (das) {
+      EXPECT_TRUE(game.doubleDown());
+      EXPECT_TRUE(game.getWasDoubledByHand()[0]);
+      EXPECT_EQ(game.observe().handIndex, 1);
+    }
+  }
+}
+
+TEST(ResplitTest, SplitAcesTakeOneCardEach) {
+  GameRules rules;
+  rules.resplitAces = false;
+  BlackjackGame game(rules, 6u);
+  // About 120 of these hands draw a ten to 21
+  for (int i = 0; i < 200; ++i) {
+    game.startRound(cardOf(Rank::ACE), cardOf(Rank::ACE), cardOf(Rank::SIX));
+    ASSERT_TRUE(game.split());
+    // Both hands stand on their one card; the round settles at once
+    ASSERT_TRUE(game.isRoundComplete());
+    ASSERT_EQ(game.getOutcomes().size(), 2u);
+    for (Outcome o : game.getOutcomes()) {
+      EXPECT_NE(o, Outcome::PLAYER_BLACKJACK);
+    }
+  }
+}
+
+TEST(ResplitTest, SplitAcesMayResplitOnlyWhenRulesAllow) {
+  GameRules rules;
+  rules.resplitAces = true;
+  BlackjackGame game(rules, 9u);
+  bool tested = false;
+  for (int i = 0; i < 500 && !tested; ++i) {
+    game.startRound(cardOf(Rank::ACE), cardOf(Rank::ACE), cardOf(Rank::SIX));
+    game.split();
+    if (game.isRoundComplete()) continue;
+    // Waiting on a hand of two aces: stand or resplit, no hit or double
+    tested = true;
+    Observation obs = game.observe();
+    EXPECT_EQ(obs.playerTotal, 12);
+    EXPECT_TRUE(obs.soft);
+    EXPECT_EQ(obs.legalActions, (ActionMask{Action::STAND, Action::SPLIT}));
+    EXPECT_FALSE(game.hit());
+    EXPECT_EQ(game.getPlayerHand().size(), 2u);
+    EXPECT_TRUE(game.split());
+    EXPECT_EQ(game.getNumHands(), 3u);
+  }
+  EXPECT_TRUE(tested);
+}
@@ -138,4 +138,47 @@ TEST_F(HandTest, SplitHandReturnsSecondCard) {
   EXPECT_EQ(returned, second);
   EXPECT_EQ(hand.size(), 1);
   EXPECT_EQ(hand.getCards()[0], first);
-}
\ No newline at end of file
+}
+
+TEST_F(HandTest, SplitAcesRecomputesValue) {
+  hand.addCard(Card(Rank::ACE, Suit::SPADES));
+  hand.addCard(Card(Rank::ACE, Suit::HEARTS));
+  EXPECT_EQ(hand.getTotal(), 12);
+
+  hand.split();
+  EXPECT_EQ(hand.getTotal(), 11);
+  EXPECT_TRUE(hand.isSoft());
+
+  hand.addCard(Card(Rank::KING, Suit::CLUBS));
+  EXPECT_TRUE(hand.isBlackjack());
+}
+
+TEST_F(HandTest, ManySmallCardsFitInline) {
+  // Eleven aces make a soft 21; a king turns it hard
+  for (int i = 0; i < 11; ++i) {
+    hand.addCard(Card(Rank::ACE, Suit::SPADES));
+  }
+  EXPECT_EQ(hand.getTotal(), 21);
+  EXPECT_TRUE(hand.isSoft());
+  hand.addCard(Card(Rank::KING, Suit::CLUBS));
+  EXPECT_EQ(hand.getTotal(), 21);
+  EXPECT_FALSE(hand.isSoft());
+
+  hand.clear();
+  for (size_t i = 0; i < Hand::MAX_CARDS; ++i) {
+    hand.addCard(Card(Rank::ACE, Suit::HEARTS));
+  }
+  EXPECT_EQ(hand.size(), Hand::MAX_CARDS);
+  EXPECT_TRUE(hand.isBust());
+  EXPECT_THROW(hand.addCard(Card(Rank::TWO, Suit::HEARTS)), std::length_error);
+}
+
+TEST_F(HandTest, CopiesAreIndependent) {
+  hand.addCard(Card(Rank::NINE, Suit::SPADES));
+  Hand copy = hand;
+  copy.addCard(Card(Rank::SEVEN, Suit::HEARTS));
+
+  EXPECT_EQ(hand.size(), 1);
+  EXPECT_EQ(hand.getTotal(), 9);
+  EXPECT_EQ(copy.getTotal(), 16);
+}
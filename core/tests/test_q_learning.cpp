@@ -1,10 +1,19 @@
+#include "ai/DoubleQLearningAgent.hpp"
+#include "ai/ExpectedSarsaAgent.hpp"
+#include "ai/Exploration.hpp"
 #include "ai/GameStateConverter.hpp"
+#include "ai/MonteCarloAgent.hpp"
 #include "ai/PolicyTable.hpp"
 #include "ai/QLearningAgent.hpp"
+#include "ai/ReplayBuffer.hpp"
 #include "ai/State.hpp"
+#include "ai/VectorEnv.hpp"
 #include "game/BlackjackGame.hpp"
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <gtest/gtest.h>
+#include <random>
 
 
 using namespace blackjack;
@@ -78,6 +87,38 @@ TEST_F(QLearningTest, PolicyTableSetAndGet) {
   EXPECT_DOUBLE_EQ(table.get(s, Action::STAND), 0.25);
 }
 
+TEST_F(QLearningTest, PolicyTableCountsVisits) {
+  PolicyTable table(0.5);
+  State s(13, 2, true);
+  EXPECT_EQ(table.getVisits(s, Action::HIT), 0u);
+  EXPECT_EQ(table.visit(s, Action::HIT), 1u);
+  EXPECT_EQ(table.visit(s, Action::HIT), 2u);
+  // A first visit marks the row with default values, like set()
+  EXPECT_EQ(table.size(), 1u);
+  EXPECT_DOUBLE_EQ(table.get(s, Action::STAND), 0.5);
+  EXPECT_EQ(table.getVisits(s, Action::STAND), 0u);
+
+  std::string path =
+      (std::filesystem::temp_directory_path() / "visits_test").string();
+  table.saveToBinary(path + ".qtable");
+  table.saveVisitsToBinary(path + ".visits");
+  PolicyTable loaded;
+  loaded.loadFromBinary(path + ".qtable");
+  EXPECT_EQ(loaded.getVisits(s, Action::HIT), 0u);
+  loaded.loadVisitsFromBinary(path + ".visits");
+  EXPECT_EQ(loaded.getVisits(s, Action::HIT), 2u);
+  auto counting = std::make_unique<CountingPolicyTable>(); // multi-MB: keep off the stack
+  EXPECT_THROW(counting->loadVisitsFromBinary(path + ".visits"),
+               std::runtime_error);
+  std::filesystem::remove(path + ".qtable");
+  std::filesystem::remove(path + ".visits");
+
+  // Counts restart with the row after a clear
+  table.clear();
+  EXPECT_EQ(table.getVisits(s, Action::HIT), 0u);
+  EXPECT_EQ(table.visit(s, Action::HIT), 1u);
+}
+
 TEST_F(QLearningTest, PolicyTableGetMaxAction) {
   PolicyTable table;
   State s(16, 10, false);
@@ -86,8 +127,7 @@ TEST_F(QLearningTest, PolicyTableGetMaxAction) {
   table.set(s, Action::STAND, 0.7);
   table.set(s, Action::DOUBLE, 0.1);
 
-  std::vector<Action> validActions = {Action::HIT, Action::STAND,
-                                      Action::DOUBLE};
+  ActionMask validActions = {Action::HIT, Action::STAND, Action::DOUBLE};
 
   Action best = table.getMaxAction(s, validActions);
   EXPECT_EQ(best, Action::STAND);
@@ -114,6 +154,292 @@ TEST_F(QLearningTest, PolicyTableSaveAndLoad) {
   std::filesystem::remove(filepath);
 }
 
+TEST_F(QLearningTest, ActionMaskIteratesInActionOrder) {
+  constexpr ActionMask mask = {Action::SURRENDER, Action::HIT, Action::DOUBLE};
+  static_assert(mask.size() == 3, "ActionMask is usable in constant expressions");
+  static_assert(sizeof(ActionMask) == 1, "ActionMask is one byte");
+
+  std::vector<Action> order(mask.begin(), mask.end());
+  EXPECT_EQ(order, (std::vector<Action>{Action::HIT, Action::DOUBLE,
+                                        Action::SURRENDER}));
+  EXPECT_EQ(mask.front(), Action::HIT);
+  EXPECT_EQ(mask.nth(2), Action::SURRENDER);
+  EXPECT_TRUE(mask.contains(Action::DOUBLE));
+  EXPECT_FALSE(mask.contains(Action::STAND));
+
+  ActionMask edited = mask;
+  edited.erase(Action::HIT);
+  edited.insert(Action::STAND);
+  EXPECT_EQ(edited, (ActionMask{Action::STAND, Action::DOUBLE,
+                                Action::SURRENDER}));
+  EXPECT_TRUE(ActionMask{}.empty());
+}
+
+TEST_F(QLearningTest, ConverterValidActionsFollowHand) {
+  Hand pair;
+  pair.addCard(Card(Rank::EIGHT, Suit::HEARTS));
+  pair.addCard(Card(Rank::EIGHT, Suit::SPADES));
+  EXPECT_EQ(GameStateConverter::getValidActions(pair, true, true, true),
+            (ActionMask{Action::HIT, Action::STAND, Action::DOUBLE,
+                        Action::SPLIT, Action::SURRENDER}));
+  EXPECT_EQ(GameStateConverter::getValidActions(pair, false, false, false),
+            ActionMask::base());
+
+  pair.addCard(Card(Rank::TWO, Suit::CLUBS));
+  EXPECT_EQ(GameStateConverter::getValidActions(pair, true, true, true),
+            ActionMask::base());
+}
+
+TEST_F(QLearningTest, MaskedArgmaxMatchesScalar) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(-3, 3);  // narrow range forces ties
+  for (int trial = 0; trial < 200; ++trial) {
+    double d[8];
+    float f[8];
+    Fixed16<> x[8];
+    for (int i = 0; i < 8; ++i) {
+      d[i] = dist(rng) * 0.25;
+      f[i] = static_cast<float>(d[i]);
+      x[i] = QValueCodec<Fixed16<>>::encode(d[i]);
+    }
+    for (unsigned mask = 1; mask < 32; ++mask) {
+      uint8_t m = static_cast<uint8_t>(mask);
+      ASSERT_EQ(maskedArgmax(d, m), maskedArgmaxScalar(d, m)) << mask;
+      ASSERT_EQ(maskedArgmax(f, m), maskedArgmaxScalar(f, m)) << mask;
+      ASSERT_EQ(maskedArgmax(x, m), maskedArgmaxScalar(x, m)) << mask;
+    }
+  }
+}
+
+TEST_F(QLearningTest, PolicyTableMaskedMaxIgnoresInvalidActions) {
+  PolicyTable table;
+  State s(11, 6, false, false, true);
+  table.set(s, Action::HIT, 0.2);
+  table.set(s, Action::STAND, -0.1);
+  table.set(s, Action::DOUBLE, 0.5);
+
+  ActionMask hitStand = ActionMask::base();
+  EXPECT_EQ(table.getMaxAction(s, hitStand), Action::HIT);
+  EXPECT_DOUBLE_EQ(table.getMaxQ(s, hitStand), 0.2);
+  EXPECT_EQ(table.getMaxAction(s, {Action::STAND, Action::DOUBLE}),
+            Action::DOUBLE);
+
+  // Unvisited: lowest valid action, default value
+  State fresh(13, 2, false);
+  EXPECT_EQ(table.getMaxAction(fresh, {Action::STAND, Action::SURRENDER}),
+            Action::STAND);
+  EXPECT_DOUBLE_EQ(table.getMaxQ(fresh, hitStand), 0.0);
+}
+
+// === True-count State Tests ===
+
+TEST_F(QLearningTest, TrueCountBucketsClampAndTruncate) {
+  EXPECT_EQ(State::bucketTrueCount(2.9), 2);
+  EXPECT_EQ(State::bucketTrueCount(-1.5), -1);
+  EXPECT_EQ(State::bucketTrueCount(12.0), State::MAX_TRUE_COUNT);
+  EXPECT_EQ(State::bucketTrueCount(-9.0), State::MIN_TRUE_COUNT);
+}
+
+TEST_F(QLearningTest, CountingPolicyTableSeparatesBuckets) {
+  auto tablePtr = std::make_unique<CountingPolicyTable>(); // multi-MB: keep off the stack
+  CountingPolicyTable &table = *tablePtr;
+  State neutral(16, 10, false, false, true, 0);
+  State rich(16, 10, false, false, true, 4);
+  ASSERT_EQ(neutral.hash(), rich.hash());
+  ASSERT_NE(neutral.countedHash(), rich.countedHash());
+
+  table.set(neutral, Action::HIT, 0.25);
+  table.set(rich, Action::STAND, 0.75);
+  EXPECT_DOUBLE_EQ(table.get(neutral, Action::HIT), 0.25);
+  EXPECT_DOUBLE_EQ(table.get(rich, Action::HIT), 0.0);
+  EXPECT_EQ(table.size(), 2u);
+
+  // The basic table ignores the bucket
+  PolicyTable basic;
+  basic.set(rich, Action::STAND, 0.75);
+  EXPECT_DOUBLE_EQ(basic.get(neutral, Action::STAND), 0.75);
+}
+
+TEST_F(QLearningTest, CountingPolicyTableSaveAndLoad) {
+  auto table1Ptr = std::make_unique<CountingPolicyTable>();
+  CountingPolicyTable &table1 = *table1Ptr;
+  State poor(13, 2, false, false, true, State::MIN_TRUE_COUNT);
+  table1.set(poor, Action::HIT, -0.3);
+
+  std::string filepath =
+      (std::filesystem::temp_directory_path() / "test_counting_qtable.bin")
+          .string();
+  table1.saveToBinary(filepath);
+
+  auto table2Ptr = std::make_unique<CountingPolicyTable>();
+  CountingPolicyTable &table2 = *table2Ptr;
+  table2.loadFromBinary(filepath);
+  EXPECT_DOUBLE_EQ(table2.get(poor, Action::HIT), -0.3);
+  EXPECT_EQ(table2.size(), 1u);
+
+  // Files are tied to their key space
+  PolicyTable basic;
+  EXPECT_THROW(basic.loadFromBinary(filepath), std::runtime_error);
+
+  std::filesystem::remove(filepath);
+}
+
+// === State layout Tests ===
+
+TEST_F(QLearningTest, LayoutTablesAreMinimallySized) {
+  EXPECT_EQ(PolicyTable::TABLE_SIZE, 4096u);
+  EXPECT_EQ(CountingPolicyTable::TABLE_SIZE, 65536u);
+  EXPECT_EQ(CompositionPolicyTable::TABLE_SIZE, 16384u);
+  EXPECT_EQ(BasicPolicyTable<HitStandLayout>::TABLE_SIZE, 1024u);
+}
+
+TEST_F(QLearningTest, LayoutKeysMatchStateHashes) {
+  for (int total = 4; total <= 21; ++total) {
+    for (int up = 1; up <= 10; ++up) {
+      for (int tc = State::MIN_TRUE_COUNT; tc <= State::MAX_TRUE_COUNT; ++tc) {
+        State s(total, up, total % 2 == 0, total % 3 == 0, true, tc);
+        EXPECT_EQ(StateKey<BasicLayout>::index(s), s.hash());
+        EXPECT_EQ(StateKey<CountLayout>::index(s), s.countedHash());
+        EXPECT_EQ(StateKey<CountLayout>::fromIndex(s.countedHash()), s);
+      }
+    }
+  }
+}
+
+TEST_F(QLearningTest, CompositionTableKeysOnCardCount) {
+  auto tablePtr = std::make_unique<CompositionPolicyTable>();
+  CompositionPolicyTable &table = *tablePtr;
+  State twoCards(16, 10, false, false, true);
+  twoCards.cardCount = 2;
+  State threeCards = twoCards;
+  threeCards.cardCount = 3;
+  State manyCards = twoCards;
+  manyCards.cardCount = 7;
+
+  table.set(twoCards, Action::HIT, -0.5);
+  table.set(threeCards, Action::STAND, -0.4);
+  table.set(manyCards, Action::STAND, -0.3);
+
+  EXPECT_DOUBLE_EQ(table.get(twoCards, Action::HIT), -0.5);
+  EXPECT_DOUBLE_EQ(table.get(threeCards, Action::HIT), 0.0);
+  // Five or more cards share the last bucket
+  State fiveCards = twoCards;
+  fiveCards.cardCount = 5;
+  EXPECT_DOUBLE_EQ(table.get(fiveCards, Action::STAND), -0.3);
+  EXPECT_EQ(table.size(), 3u);
+}
+
+TEST_F(QLearningTest, LayoutTablesRejectOtherLayoutsOnLoad) {
+  auto tablePtr = std::make_unique<CompositionPolicyTable>();
+  CompositionPolicyTable &table = *tablePtr;
+  State s(12, 4, false, false, true);
+  s.cardCount = 3;
+  table.set(s, Action::STAND, 0.2);
+
+  std::string filepath =
+      (std::filesystem::temp_directory_path() / "test_composition_qtable.bin")
+          .string();
+  table.saveToBinary(filepath);
+
+  auto reloadedPtr = std::make_unique<CompositionPolicyTable>();
+  CompositionPolicyTable &reloaded = *reloadedPtr;
+  reloaded.loadFromBinary(filepath);
+  EXPECT_DOUBLE_EQ(reloaded.get(s, Action::STAND), 0.2);
+
+  auto countingPtr = std::make_unique<CountingPolicyTable>();
+  CountingPolicyTable &counting = *countingPtr;
+  EXPECT_THROW(counting.loadFromBinary(filepath), std::runtime_error);
+
+  std::filesystem::remove(filepath);
+}
+
+TEST_F(QLearningTest, FloatTableSharesFastPath) {
+  BasicPolicyTable<BasicLayout, float> table;
+  State s(15, 7, false);
+  table.set(s, Action::HIT, 0.1);
+  table.set(s, Action::STAND, -0.2);
+
+  EXPECT_NEAR(table.get(s, Action::HIT), 0.1, 1e-7);
+  EXPECT_EQ(table.getMaxAction(s, {Action::HIT, Action::STAND}), Action::HIT);
+  EXPECT_NEAR(table.getMaxQ(s, {Action::HIT, Action::STAND}), 0.1, 1e-7);
+}
+
+// === Storage precision Tests ===
+
+TEST_F(QLearningTest, Fixed16RoundsAndSaturates) {
+  using Codec = QValueCodec<Fixed16<>>;
+  EXPECT_NEAR(Codec::decode(Codec::encode(0.123)), 0.123, 0.5 / 4096);
+  EXPECT_NEAR(Codec::decode(Codec::encode(-1.5)), -1.5, 1e-12);
+  EXPECT_NEAR(Codec::decode(Codec::encode(100.0)), 32767.0 / 4096, 1e-12);
+  EXPECT_NEAR(Codec::decode(Codec::encode(-100.0)), -32767.0 / 4096, 1e-12);
+}
+
+TEST_F(QLearningTest, ReducedPrecisionRowsShrink) {
+  EXPECT_EQ(sizeof(PolicyTable::Row), 64u);
+  EXPECT_EQ(sizeof(FloatPolicyTable::Row), 32u);
+  EXPECT_EQ(sizeof(Fixed16PolicyTable::Row), 16u);
+}
+
+TEST_F(QLearningTest, PrecisionsRoundTripAndConvertOnLoad) {
+  PolicyTable exact;
+  State s(17, 10, false, false, true);
+  exact.set(s, Action::STAND, -0.4231);
+  exact.set(s, Action::HIT, -0.5123);
+
+  auto dir = std::filesystem::temp_directory_path();
+  std::string doublePath = (dir / "test_precision_double.bin").string();
+  std::string fixedPath = (dir / "test_precision_fixed.bin").string();
+  exact.saveToBinary(doublePath);
+
+  // A double checkpoint loads into a fixed-point table...
+  Fixed16PolicyTable fixed;
+  fixed.loadFromBinary(doublePath);
+  EXPECT_NEAR(fixed.get(s, Action::STAND), -0.4231, 0.5 / 4096);
+  EXPECT_EQ(fixed.getMaxAction(s, {Action::HIT, Action::STAND}),
+            Action::STAND);
+
+  // ...and a fixed-point checkpoint is smaller and loads back as float
+  fixed.saveToBinary(fixedPath);
+  EXPECT_LT(std::filesystem::file_size(fixedPath),
+            std::filesystem::file_size(doublePath));
+  FloatPolicyTable widened;
+  widened.loadFromBinary(fixedPath);
+  EXPECT_NEAR(widened.get(s, Action::HIT), -0.5123, 0.5 / 4096);
+  EXPECT_EQ(widened.size(), 1u);
+
+  std::filesystem::remove(doublePath);
+  std::filesystem::remove(fixedPath);
+}
+
+TEST_F(QLearningTest, ReducedPrecisionAgentsLearn) {
+  Fixed16QLearningAgent fixedAgent(params);
+  FloatQLearningAgent floatAgent(params);
+  State s(20, 6, false);
+  Experience exp(s, Action::STAND, 1.0, State(), true);
+  for (int i = 0; i < 50; ++i) {
+    fixedAgent.learn(exp);
+    floatAgent.learn(exp);
+  }
+  EXPECT_NEAR(fixedAgent.getQValue(s, Action::STAND),
+              floatAgent.getQValue(s, Action::STAND), 1e-3);
+  EXPECT_GT(fixedAgent.getQValue(s, Action::STAND), 0.9);
+  EXPECT_EQ(fixedAgent.getName(), "Q-Learning [fixed16]");
+}
+
+TEST_F(QLearningTest, OnlyCountingAgentUsesTrueCount) {
+  EXPECT_FALSE(QLearningAgent(params).usesTrueCount());
+  auto counting = std::make_unique<CountingQLearningAgent>(params);
+  EXPECT_TRUE(counting->usesTrueCount());
+
+  State rich(16, 10, false, false, true, 3);
+  Experience exp(rich, Action::STAND, 1.0, State(), true);
+  counting->learn(exp);
+  EXPECT_GT(counting->getQValue(rich, Action::STAND), 0.0);
+  EXPECT_DOUBLE_EQ(counting->getQValue(State(16, 10, false, false, true),
+                                       Action::STAND),
+                   0.0);
+}
+
 // === Q-Learning Agent Tests ===
 
 TEST_F(QLearningTest, AgentInitialization) {
@@ -129,7 +455,7 @@ TEST_F(QLearningTest, AgentChoosesRandomActionWhenExploring) {
   QLearningAgent agent(params);
 
   State s(16, 10, false);
-  std::vector<Action> validActions = {Action::HIT, Action::STAND};
+  ActionMask validActions = {Action::HIT, Action::STAND};
 
   // Should choose randomly
   std::map<Action, int> actionCounts;
@@ -156,7 +482,7 @@ TEST_F(QLearningTest, AgentExploitsWhenNotTraining) {
   Experience exp2(s, Action::STAND, 1.0, State(4, 1, false), true);
   agent.learn(exp2);
 
-  std::vector<Action> validActions = {Action::HIT, Action::STAND};
+  ActionMask validActions = {Action::HIT, Action::STAND};
 
   // When not training (exploitation), should always choose STAND
   agent.setEpsilon(0.0); // Force exploitation
@@ -246,8 +572,11 @@ TEST_F(QLearningTest, AgentSaveAndLoad) {
   EXPECT_DOUBLE_EQ(agent2.getQValue(s1, Action::HIT), q1);
   EXPECT_DOUBLE_EQ(agent2.getQValue(s2, Action::STAND), q2);
 
+  EXPECT_EQ(agent2.getVisitCount(s1, Action::HIT), 1.0);
+
   // Cleanup
   std::filesystem::remove(filepath + ".qtable");
+  std::filesystem::remove(filepath + ".visits");
   std::filesystem::remove(filepath + ".meta");
 }
 
@@ -274,7 +603,7 @@ TEST_F(QLearningTest, AgentLearnsSimpleStrategy) {
 
   // Agent should prefer STAND
   agent.setEpsilon(0.0); // Pure exploitation
-  std::vector<Action> validActions = {Action::HIT, Action::STAND};
+  ActionMask validActions = {Action::HIT, Action::STAND};
   Action chosen = agent.chooseAction(s, validActions, false);
 
   EXPECT_EQ(chosen, Action::STAND);
@@ -309,7 +638,7 @@ TEST_F(QLearningTest, AgentLearnsToHitOn16VsTen) {
 
   // Agent should prefer HIT (higher expected value)
   agent.setEpsilon(0.0);
-  std::vector<Action> validActions = {Action::HIT, Action::STAND};
+  ActionMask validActions = {Action::HIT, Action::STAND};
   Action chosen = agent.chooseAction(s, validActions, false);
 
   EXPECT_EQ(chosen, Action::HIT);
@@ -356,4 +685,449 @@ TEST_F(QLearningTest, DoubleDownRewardMultiplier) {
       GameStateConverter::outcomeToReward(Outcome::DEALER_WIN, true), -2.0);
   EXPECT_DOUBLE_EQ(
       GameStateConverter::outcomeToReward(Outcome::PUSH, true), 0.0);
-}
\ No newline at end of file
+}
+
+TEST_F(QLearningTest, SnapshotIsIndependentCopy) {
+  QLearningAgent agent(params);
+  State s(16, 10, false);
+  agent.learn(Experience(s, Action::HIT, -1.0, State(4, 1, false), true));
+
+  std::unique_ptr<Agent> snapshot = agent.snapshot();
+  ASSERT_NE(snapshot, nullptr);
+  double frozen = snapshot->getQValue(s, Action::HIT);
+  EXPECT_DOUBLE_EQ(frozen, agent.getQValue(s, Action::HIT));
+
+  agent.learn(Experience(s, Action::HIT, -1.0, State(4, 1, false), true));
+  EXPECT_DOUBLE_EQ(snapshot->getQValue(s, Action::HIT), frozen);
+  EXPECT_NE(agent.getQValue(s, Action::HIT), frozen);
+}
+
+TEST_F(QLearningTest, ConcurrentSeedStaysWithItsAgent) {
+  // epsilon = 1: every training choice is a draw from the thread's generator
+  State s(12, 6, false);
+  auto draws = [&](QLearningAgent &agent) {
+    std::vector<Action> actions;
+    for (int i = 0; i < 32; ++i) {
+      actions.push_back(agent.chooseAction(s, ActionMask::base(), true));
+    }
+    return actions;
+  };
+  auto reference = std::make_unique<QLearningAgent>(params);
+  ASSERT_TRUE(reference->enableConcurrentLearning());
+  reference->seed(5);
+  const std::vector<Action> expected = draws(*reference);
+
+  // Seeding another agent on this thread leaves a's generator alone
+  auto a = std::make_unique<QLearningAgent>(params);
+  auto b = std::make_unique<QLearningAgent>(params);
+  a->enableConcurrentLearning();
+  b->enableConcurrentLearning();
+  a->seed(5);
+  b->seed(6);
+  b->chooseAction(s, ActionMask::base(), true);
+  EXPECT_EQ(draws(*a), expected);
+}
+
+namespace {
+
+/** Hit below 17, split pairs, otherwise stand. */
+Action simplePolicy(const State &state, ActionMask valid) {
+  if (valid.contains(Action::SPLIT)) return Action::SPLIT;
+  return state.playerTotal < 17 ? Action::HIT : Action::STAND;
+}
+
+} // namespace
+
+TEST(VectorEnvTest, EachGameReplaysItsStream) {
+  GameRules rules;
+  const size_t numEnvs = 3;
+  VectorEnv env(rules, numEnvs, 5u, 10);
+  std::vector<std::vector<double>> rewards(numEnvs);
+  std::vector<Action> actions(numEnvs);
+  for (int step = 0; step < 3000; ++step) {
+    for (size_t i = 0; i < numEnvs; ++i) {
+      actions[i] = simplePolicy(env.states()[i], env.validActions()[i]);
+    }
+    env.step(actions);
+    for (size_t i = 0; i < numEnvs; ++i) {
+      if (env.dones()[i]) rewards[i].push_back(env.rewards()[i]);
+    }
+  }
+
+  // Each game's decided rounds match a lone game on the same stream
+  double total = 0.0;
+  size_t rounds = 0;
+  for (size_t i = 0; i < numEnvs; ++i) {
+    BlackjackGame game(rules, 5u, 10 + i);
+    size_t decided = 0;
+    while (decided < rewards[i].size()) {
+      game.startRound();
+      Observation obs = game.observe();
+      bool natural = obs.done;
+      while (!obs.done) {
+        obs = game.step(simplePolicy(GameStateConverter::toAIState(obs),
+                                     obs.legalActions));
+      }
+      double reward = 0.0;
+      const auto &outcomes = game.getOutcomes();
+      for (size_t h = 0; h < outcomes.size(); ++h) {
+        reward += GameStateConverter::outcomeToReward(
+            outcomes[h], game.getWasDoubledByHand()[h]);
+      }
+      total += reward;
+      ++rounds;
+      if (!natural) {
+        EXPECT_DOUBLE_EQ(reward, rewards[i][decided]) << "game " << i;
+        ++decided;
+      }
+    }
+  }
+  EXPECT_EQ(env.roundsPlayed(), rounds);
+  EXPECT_NEAR(env.totalReward(), total, 1e-9);
+}
+
+TEST(VectorEnvTest, AlwaysPresentsADecision) {
+  VectorEnv env(GameRules{}, 4, 1u, 0, true);
+  std::vector<Action> actions(env.size(), Action::HIT);
+  for (int step = 0; step < 500; ++step) {
+    for (size_t i = 0; i < env.size(); ++i) {
+      EXPECT_TRUE(env.states()[i].isValid());
+      EXPECT_TRUE(env.validActions()[i].contains(Action::STAND));
+      EXPECT_FALSE(env.game(i).isRoundComplete());
+    }
+    env.step(actions);
+  }
+  EXPECT_GT(env.roundsPlayed(), 0u);
+  EXPECT_THROW(env.step(std::vector<Action>(2)), std::invalid_argument);
+  EXPECT_THROW(VectorEnv(GameRules{}, 0), std::invalid_argument);
+}
+
+TEST_F(QLearningTest, BatchedChooseActionsMatchesSingle) {
+  params.epsilon = 0.0;
+  params.epsilonMin = 0.0;
+  QLearningAgent agent(params);
+  agent.learn(Experience(State(16, 10, false), Action::STAND, 1.0, State(),
+                         true));
+  VectorEnv env(GameRules{}, 8, 3u);
+  std::vector<Action> actions(env.size());
+  agent.chooseActions(env.states().data(), env.validActions().data(),
+                      actions.data(), env.size(), false);
+  for (size_t i = 0; i < env.size(); ++i) {
+    EXPECT_EQ(actions[i], agent.chooseAction(env.states()[i],
+                                             env.validActions()[i], false));
+  }
+}
+
+TEST(ReplayBufferTest, PackedExperienceRoundTrips) {
+  State state(13, 1, true, false, true, -3);
+  state.cardCount = 2;
+  State next(17, 1, true, false, false, 5);
+  next.cardCount = 3;
+  Experience exp(state, Action::HIT, -1.5, next, false,
+                 ActionMask{Action::HIT, Action::STAND});
+  Experience back = PackedExperience(exp).unpack();
+  EXPECT_EQ(back.state, state);
+  EXPECT_EQ(back.nextState, next);
+  EXPECT_EQ(back.action, Action::HIT);
+  EXPECT_EQ(back.reward, -1.5);
+  EXPECT_EQ(back.validNextActions, exp.validNextActions);
+  EXPECT_FALSE(back.done);
+  EXPECT_EQ(State::unpack(State().pack()), State());
+}
+
+TEST(ReplayBufferTest, RingEvictsOldest) {
+  EXPECT_THROW(ReplayBuffer(0), std::invalid_argument);
+  ReplayBuffer buffer(3);
+  for (int total = 4; total < 9; ++total) {
+    buffer.add(Experience(State(total, 5, false), Action::STAND, 1.0,
+                          State(), true));
+  }
+  EXPECT_EQ(buffer.size(), 3u);
+  std::vector<int> totals;
+  for (size_t slot = 0; slot < buffer.size(); ++slot) {
+    totals.push_back(State::unpack(buffer[slot].state).playerTotal);
+  }
+  std::sort(totals.begin(), totals.end());
+  EXPECT_EQ(totals, (std::vector<int>{6, 7, 8}));
+}
+
+TEST(ReplayBufferTest, PrioritizedSamplingFollowsPriorities) {
+  ReplayBuffer buffer(5);
+  const double priorities[] = {1.0, 0.0, 2.0, 0.0, 5.0};
+  for (int i = 0; i < 5; ++i) {
+    buffer.add(Experience(State(4 + i, 2, false), Action::HIT, 0.0, State(),
+                          true),
+               priorities[i]);
+  }
+  EXPECT_DOUBLE_EQ(buffer.totalPriority(), 8.0);
+
+  Rng rng(3u);
+  std::vector<Experience> sample;
+  std::vector<size_t> slots;
+  buffer.samplePrioritized(rng, 16000, sample, &slots);
+  ASSERT_EQ(slots.size(), 16000u);
+  int counts[5] = {};
+  for (size_t i = 0; i < slots.size(); ++i) {
+    ++counts[slots[i]];
+    EXPECT_EQ(sample[i].state.playerTotal, 4 + static_cast<int>(slots[i]));
+  }
+  EXPECT_NEAR(counts[0], 2000, 200);
+  EXPECT_EQ(counts[1], 0);
+  EXPECT_NEAR(counts[2], 4000, 250);
+  EXPECT_EQ(counts[3], 0);
+  EXPECT_NEAR(counts[4], 10000, 300);
+
+  buffer.setPriority(4, 0.0);
+  buffer.samplePrioritized(rng, 1000, sample, &slots);
+  EXPECT_EQ(std::count(slots.begin(), slots.end(), 4u), 0);
+  buffer.sampleUniform(rng, 10, sample);
+  EXPECT_EQ(sample.size(), 10u);
+}
+
+TEST_F(QLearningTest, LearnBatchUpdatesWithoutDecay) {
+  QLearningAgent agent(params);
+  const double epsilon = agent.getEpsilon();
+  State state(12, 4, false);
+  std::vector<Experience> batch(
+      8, Experience(state, Action::STAND, 1.0, State(), true));
+  agent.learnBatch(batch.data(), batch.size());
+  EXPECT_DOUBLE_EQ(agent.getEpsilon(), epsilon);
+  // Eight terminal updates toward 1: 1 - (1 - alpha)^8
+  EXPECT_NEAR(agent.getQValue(state, Action::STAND),
+              1.0 - std::pow(1.0 - params.learningRate, 8), 1e-12);
+}
+
+TEST(MonteCarloAgentTest, ReturnReachesEveryStepOfTheRound) {
+  MonteCarloAgent::Hyperparameters params;
+  params.learningRate = 0.0;
+  params.discountFactor = 0.5;
+  auto agent = std::make_unique<MonteCarloAgent>(params);
+  State s1(12, 10, false), s2(15, 10, false), s3(18, 10, false);
+  agent->learn(Experience(s1, Action::HIT, 0.0, s2, false));
+  agent->learn(Experience(s2, Action::HIT, 0.0, s3, false));
+  // Nothing is learned until the round ends
+  EXPECT_EQ(agent->getQValue(s1, Action::HIT), 0.0);
+  agent->learn(Experience(s3, Action::STAND, 1.0, State(), true));
+
+  EXPECT_DOUBLE_EQ(agent->getQValue(s3, Action::STAND), 1.0);
+  EXPECT_DOUBLE_EQ(agent->getQValue(s2, Action::HIT), 0.5);
+  EXPECT_DOUBLE_EQ(agent->getQValue(s1, Action::HIT), 0.25);
+
+  // Sample average: a second return of -1 halves the way back
+  agent->learn(Experience(s3, Action::STAND, -1.0, State(), true));
+  EXPECT_DOUBLE_EQ(agent->getQValue(s3, Action::STAND), 0.0);
+  EXPECT_EQ(agent->getVisitCount(s3, Action::STAND), 2.0);
+}
+
+TEST(MonteCarloAgentTest, FirstVisitCountsARepeatOnce) {
+  State pair(16, 9, false, true, true);
+  State repeat(16, 9, false, true, true);
+  for (bool firstVisit : {true, false}) {
+    MonteCarloAgent::Hyperparameters params;
+    params.learningRate = 0.0;
+    params.firstVisit = firstVisit;
+    auto agent = std::make_unique<MonteCarloAgent>(params);
+    agent->learn(Experience(pair, Action::STAND, 0.0, repeat, false));
+    agent->learn(Experience(repeat, Action::STAND, 2.0, State(), true));
+    EXPECT_EQ(agent->getVisitCount(pair, Action::STAND), firstVisit ? 1.0 : 2.0);
+    EXPECT_DOUBLE_EQ(agent->getQValue(pair, Action::STAND), 2.0);
+  }
+}
+
+TEST(MonteCarloAgentTest, SaveLoadRoundTrip) {
+  MonteCarloAgent::Hyperparameters params;
+  auto agent = std::make_unique<MonteCarloAgent>(params);
+  State state(11, 6, false, false, true);
+  agent->learn(Experience(state, Action::DOUBLE, 2.0, State(), true));
+  std::string path =
+      (std::filesystem::temp_directory_path() / "mc_agent_test").string();
+  agent->save(path);
+
+  auto loaded = std::make_unique<MonteCarloAgent>(params);
+  loaded->load(path);
+  EXPECT_EQ(loaded->getQValue(state, Action::DOUBLE),
+            agent->getQValue(state, Action::DOUBLE));
+  EXPECT_EQ(loaded->getVisitCount(state, Action::DOUBLE), 1.0);
+  EXPECT_EQ(loaded->getName(), "Monte Carlo");
+
+  // The Q file is a plain table checkpoint
+  PolicyTable table;
+  table.loadFromBinary(path + ".qtable");
+  EXPECT_EQ(table.get(state, Action::DOUBLE),
+            agent->getQValue(state, Action::DOUBLE));
+  for (const char *ext : {".qtable", ".visits", ".meta"}) {
+    std::filesystem::remove(path + ext);
+  }
+}
+
+TEST_F(QLearningTest, ExpectedSarsaTargetAveragesOverExploration) {
+  params.learningRate = 1.0;
+  params.discountFactor = 1.0;
+  State state(12, 10, false), next(15, 10, false);
+  const ActionMask nextActions = ActionMask::base();
+  for (double epsilon : {0.0, 0.5}) {
+    params.epsilon = epsilon;
+    params.epsilonMin = 0.0;
+    auto sarsa = std::make_unique<ExpectedSarsaAgent>(params);
+    auto qLearning = std::make_unique<QLearningAgent>(params);
+    // Q(next) = {HIT: 1, STAND: 0}
+    Experience seed(next, Action::HIT, 1.0, State(), true);
+    Experience step(state, Action::HIT, 0.0, next, false, nextActions);
+    for (Agent *agent : {static_cast<Agent *>(sarsa.get()),
+                         static_cast<Agent *>(qLearning.get())}) {
+      agent->learnBatch(&seed, 1);
+      agent->learnBatch(&step, 1);
+    }
+    EXPECT_DOUBLE_EQ(qLearning->getQValue(state, Action::HIT), 1.0);
+    // (1 - eps) * max + eps * mean = 1 - eps / 2
+    EXPECT_DOUBLE_EQ(sarsa->getQValue(state, Action::HIT), 1.0 - epsilon / 2);
+  }
+  EXPECT_EQ(ExpectedSarsaAgent(params).getName(), "Expected SARSA");
+}
+
+TEST_F(QLearningTest, DoubleQUpdatesOneTablePerStep) {
+  params.learningRate = 1.0;
+  auto agent = std::make_unique<DoubleQLearningAgent>(params);
+  agent->seed(7);
+  State state(20, 6, false);
+  Experience win(state, Action::STAND, 1.0, State(), true);
+  agent->learn(win);
+  // One table holds 1, the other still 0
+  EXPECT_DOUBLE_EQ(agent->getQValue(state, Action::STAND), 0.5);
+  for (int i = 0; i < 64; ++i) {
+    agent->learnBatch(&win, 1);
+  }
+  EXPECT_DOUBLE_EQ(agent->getQValue(state, Action::STAND), 1.0);
+  EXPECT_EQ(agent->chooseAction(state, ActionMask::base(), false),
+            Action::STAND);
+  EXPECT_LT(agent->getEpsilon(), params.epsilon);
+}
+
+TEST_F(QLearningTest, DoubleQSaveLoadRoundTrip) {
+  auto agent = std::make_unique<DoubleQLearningAgent>(params);
+  agent->seed(11);
+  State state(11, 6, false, false, true);
+  for (int i = 0; i < 5; ++i) {
+    agent->learn(Experience(state, Action::DOUBLE, 2.0, State(), true));
+  }
+  std::string path =
+      (std::filesystem::temp_directory_path() / "double_q_test").string();
+  agent->save(path);
+
+  auto loaded = std::make_unique<DoubleQLearningAgent>(params);
+  loaded->load(path);
+  EXPECT_EQ(loaded->getQValue(state, Action::DOUBLE),
+            agent->getQValue(state, Action::DOUBLE));
+  EXPECT_NEAR(loaded->getEpsilon(), agent->getEpsilon(), 1e-5);
+  EXPECT_EQ(loaded->getName(), "Double Q-Learning");
+
+  // Table A is a plain table checkpoint
+  PolicyTable tableA, tableB;
+  tableA.loadFromBinary(path + ".qtable");
+  tableB.loadFromBinary(path + ".qtable2");
+  EXPECT_DOUBLE_EQ((tableA.get(state, Action::DOUBLE) +
+                    tableB.get(state, Action::DOUBLE)) / 2,
+                   agent->getQValue(state, Action::DOUBLE));
+  for (const char *ext :
+       {".qtable", ".qtable2", ".visits", ".visits2", ".meta"}) {
+    std::filesystem::remove(path + ext);
+  }
+}
+
+TEST_F(QLearningTest, StepSchedulesFollowVisitCount) {
+  params.learningRate = 0.2;
+  EXPECT_DOUBLE_EQ(params.stepSize(1), 0.2);
+  EXPECT_DOUBLE_EQ(params.stepSize(100), 0.2);
+  params.stepSchedule = StepSchedule::HARMONIC;
+  EXPECT_DOUBLE_EQ(params.stepSize(4), 0.25);
+  params.stepSchedule = StepSchedule::POLYNOMIAL;
+  params.stepExponent = 0.5 + 1e-9;
+  EXPECT_NEAR(params.stepSize(16), 0.25, 1e-8);
+  params.stepExponent = 0.5;
+  EXPECT_FALSE(params.isValid());
+
+  // 1/N makes each Q-value the plain average of its terminal rewards
+  params.stepSchedule = StepSchedule::HARMONIC;
+  params.stepExponent = 0.8;
+  auto agent = std::make_unique<QLearningAgent>(params);
+  State state(13, 2, true);
+  const double rewards[] = {1.0, -1.0, 0.0, 1.0, 1.0};
+  for (double reward : rewards) {
+    agent->learn(Experience(state, Action::HIT, reward, State(), true));
+  }
+  EXPECT_DOUBLE_EQ(agent->getQValue(state, Action::HIT), 0.4);
+  EXPECT_EQ(agent->getVisitCount(state, Action::HIT), 5.0);
+  EXPECT_TRUE(agent->countsVisits());
+}
+
+TEST(ExplorationTest, ProbabilitiesFollowEachStrategy) {
+  const ActionValues values = {0.5, -0.5, 0.0, 0.0, 0.0};
+  ActionVisits visits = {3, 1, 0, 0, 0};
+  const ActionMask valid = ActionMask::base(); // HIT, STAND
+  ExplorationParams params;
+
+  ActionValues p = explorationProbabilities(params, values, visits, valid,
+                                            0.2, 1.0, 0.0);
+  EXPECT_DOUBLE_EQ(p[0], 0.9);
+  EXPECT_DOUBLE_EQ(p[1], 0.1);
+  EXPECT_EQ(p[2], 0.0);
+
+  // Four state visits with h = 4 halve epsilon
+  params.strategy = ExplorationStrategy::STATE_EPSILON;
+  params.stateEpsilonHalfLife = 4.0;
+  p = explorationProbabilities(params, values, visits, valid, 0.2, 1.0, 0.0);
+  EXPECT_DOUBLE_EQ(p[1], 0.05);
+
+  params.strategy = ExplorationStrategy::BOLTZMANN;
+  p = explorationProbabilities(params, values, visits, valid, 0.2, 0.5, 0.0);
+  EXPECT_NEAR(p[0] + p[1], 1.0, 1e-12);
+  EXPECT_NEAR(p[0] / p[1], std::exp(1.0 / 0.5), 1e-9);
+
+  // UCB: bound 0.5 + c*sqrt(ln 4 / 3) vs -0.5 + c*sqrt(ln 4)
+  params.strategy = ExplorationStrategy::UCB;
+  params.ucbConstant = 3.0;
+  p = explorationProbabilities(params, values, visits, valid, 0.2, 1.0, 0.0);
+  EXPECT_EQ(p[1], 1.0);
+  params.ucbConstant = 0.5;
+  p = explorationProbabilities(params, values, visits, valid, 0.2, 1.0, 0.0);
+  EXPECT_EQ(p[0], 1.0);
+  // An untried action always goes first
+  visits[1] = 0;
+  Rng rng(1);
+  EXPECT_EQ(exploreAction(params, values, visits, valid, 0.2, 1.0, 0.0, rng),
+            Action::STAND);
+}
+
+TEST_F(QLearningTest, UcbAgentTriesEveryActionBeforeRepeating) {
+  params.exploration.strategy = ExplorationStrategy::UCB;
+  auto agent = std::make_unique<QLearningAgent>(params);
+  State state(11, 6, false, false, true);
+  const ActionMask valid = {Action::HIT, Action::STAND, Action::DOUBLE};
+  std::vector<Action> tried;
+  for (int i = 0; i < 3; ++i) {
+    Action action = agent->chooseAction(state, valid);
+    tried.push_back(action);
+    agent->learn(Experience(state, action, -1.0, State(), true));
+  }
+  std::sort(tried.begin(), tried.end());
+  EXPECT_EQ(tried, std::vector<Action>(valid.begin(), valid.end()));
+  // Count-driven: no global epsilon decay
+  EXPECT_DOUBLE_EQ(agent->getEpsilon(), params.epsilon);
+  EXPECT_DOUBLE_EQ(agent->getExplorationRate(),
+                   params.exploration.ucbConstant);
+}
+
+TEST_F(QLearningTest, BoltzmannTemperatureDecaysPerStep) {
+  params.exploration.strategy = ExplorationStrategy::BOLTZMANN;
+  params.exploration.temperatureDecay = 0.5;
+  params.exploration.temperatureMin = 0.2;
+  auto agent = std::make_unique<QLearningAgent>(params);
+  State state(12, 4, false);
+  for (int i = 0; i < 2; ++i) {
+    agent->learn(Experience(state, Action::STAND, 1.0, State(), true));
+  }
+  EXPECT_DOUBLE_EQ(agent->getExplorationRate(), 0.25);
+  agent->learn(Experience(state, Action::STAND, 1.0, State(), true));
+  EXPECT_DOUBLE_EQ(agent->getTemperature(), 0.2);
+  EXPECT_DOUBLE_EQ(agent->getEpsilon(), params.epsilon);
+}
@@ -0,0 +1,197 @@
+#include "solver/StrategySolver.hpp"
+#include "training/Evaluator.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+
+using namespace blackjack;
+using namespace blackjack::ai;
+using namespace blackjack::solver;
+
+class SolverTest : public ::testing::Test {
+protected:
+  StrategySolver vegas{GameRules::vegasStrip()};
+};
+
+// === Dealer outcomes ===
+
+TEST_F(SolverTest, DealerOutcomesSumToOne) {
+  for (int up = 1; up <= 10; ++up) {
+    double sum = 0.0;
+    for (double p : vegas.dealerOutcomes(up).p) {
+      EXPECT_GE(p, 0.0);
+      sum += p;
+    }
+    EXPECT_NEAR(sum, 1.0, 1e-12) << "upcard=" << up;
+  }
+}
+
+TEST_F(SolverTest, DealerBustRateVsSixMatchesPublishedValue) {
+  // Six-deck S17: dealer busts ~42.3% of the time showing a 6
+  EXPECT_NEAR(vegas.dealerOutcomes(6).p[DealerOutcomes::BUST], 0.423, 0.005);
+}
+
+TEST_F(SolverTest, HitSoft17IncreasesDealerBustRate) {
+  GameRules h17 = GameRules::vegasStrip();
+  h17.dealerHitsSoft17 = true;
+  StrategySolver solver(h17);
+
+  EXPECT_GT(solver.dealerOutcomes(6).p[DealerOutcomes::BUST],
+            vegas.dealerOutcomes(6).p[DealerOutcomes::BUST]);
+  EXPECT_LT(solver.dealerOutcomes(6).p[0], vegas.dealerOutcomes(6).p[0]);
+}
+
+TEST_F(SolverTest, DealerCacheRemoveAndRestoreRoundTrips) {
+  DealerProbabilities dealer(GameRules::singleDeck());
+  DealerOutcomes before = dealer.get(6);
+
+  dealer.removeCard(10);
+  dealer.removeCard(10);
+  // Fewer tens: the dealer busts less often showing a 6
+  EXPECT_LT(dealer.bustProbability(6), before.p[DealerOutcomes::BUST]);
+
+  dealer.addCard(10);
+  dealer.addCard(10);
+  for (size_t i = 0; i < before.p.size(); ++i) {
+    EXPECT_DOUBLE_EQ(dealer.get(6).p[i], before.p[i]);
+  }
+}
+
+TEST_F(SolverTest, DealerCacheRejectsMissingCards) {
+  Composition noAces = shoeComposition(1);
+  noAces[1] = 0;
+  DealerProbabilities dealer(GameRules::singleDeck(), noAces);
+  EXPECT_THROW(dealer.removeCard(1), std::logic_error);
+  EXPECT_THROW(dealer.get(11), std::out_of_range);
+}
+
+TEST_F(SolverTest, InfiniteDeckDealerOutcomes) {
+  GameRules infinite = GameRules::vegasStrip();
+  infinite.numDecks = 0;
+  const DealerProbabilities &dealer = DealerProbabilities::forRules(infinite);
+
+  ASSERT_TRUE(dealer.isInfinite());
+  EXPECT_THROW(const_cast<DealerProbabilities &>(dealer).removeCard(10),
+               std::logic_error);
+  // Infinite-deck S17: dealer busts ~42.3% showing a 6
+  EXPECT_NEAR(dealer.bustProbability(6), 0.4228, 0.001);
+
+  // The solver accepts an infinite deck too
+  StrategySolver solver(infinite);
+  EXPECT_EQ(solver.bestAction(State(16, 10, false, false, true)), Action::HIT);
+}
+
+TEST_F(SolverTest, SharedDealerCacheMatchesSolver) {
+  const DealerProbabilities &shared =
+      DealerProbabilities::forRules(GameRules::vegasStrip());
+  EXPECT_EQ(&shared, &DealerProbabilities::forRules(GameRules::vegasStrip()));
+  for (int up = 1; up <= 10; ++up) {
+    EXPECT_EQ(shared.get(up).p, vegas.dealerOutcomes(up).p) << "upcard=" << up;
+  }
+}
+
+// === Optimal actions ===
+
+TEST_F(SolverTest, BasicStrategyDecisions) {
+  EXPECT_EQ(vegas.bestAction(State(16, 10, false, false, true)), Action::HIT);
+  EXPECT_EQ(vegas.bestAction(State(12, 4, false, false, true)), Action::STAND);
+  EXPECT_EQ(vegas.bestAction(State(11, 6, false, false, true)), Action::DOUBLE);
+  EXPECT_EQ(vegas.bestAction(State(18, 9, true, false, true)), Action::HIT);
+  EXPECT_EQ(vegas.bestAction(State(20, 10, false, false, false)), Action::STAND);
+}
+
+TEST_F(SolverTest, SplitsAcesAndEights) {
+  EXPECT_EQ(vegas.bestAction(State(12, 6, true, true, true)), Action::SPLIT);
+  EXPECT_EQ(vegas.bestAction(State(16, 9, false, true, true)), Action::SPLIT);
+  // Never split tens
+  EXPECT_NE(vegas.bestAction(State(20, 6, false, true, true)), Action::SPLIT);
+}
+
+TEST_F(SolverTest, SplitValueFollowsSplitRules) {
+  auto splitEv = [](const GameRules &rules, int pairTotal, bool soft, int up) {
+    return StrategySolver(rules).expectedValue(
+        State(pairTotal, up, soft, true, true), Action::SPLIT);
+  };
+  GameRules rules;
+  rules.doubleAfterSplit = false;
+  GameRules das = rules;
+  das.doubleAfterSplit = true;
+  // DAS makes 4,4 vs 5 a split, not a hit
+  EXPECT_GT(splitEv(das, 8, false, 5), splitEv(rules, 8, false, 5));
+  EXPECT_EQ(StrategySolver(das).bestAction(State(8, 5, false, true, true)),
+            Action::SPLIT);
+  EXPECT_NE(StrategySolver(rules).bestAction(State(8, 5, false, true, true)),
+            Action::SPLIT);
+
+  GameRules oneSplit = rules;
+  oneSplit.maxSplits = 1;
+  EXPECT_GT(splitEv(rules, 16, false, 6), splitEv(oneSplit, 16, false, 6));
+
+  GameRules resplitAces = rules;
+  resplitAces.resplitAces = true;
+  EXPECT_GT(splitEv(resplitAces, 12, true, 6), splitEv(rules, 12, true, 6));
+
+  GameRules noSplits = rules;
+  noSplits.maxSplits = 0;
+  EXPECT_FALSE(StrategySolver(noSplits)
+                   .legalActions(State(16, 6, false, true, true))
+                   .contains(Action::SPLIT));
+  // Split aces awaiting a resplit: stand or split only
+  EXPECT_EQ(StrategySolver(resplitAces).legalActions(
+                State(12, 6, true, true, false)),
+            (ActionMask{Action::STAND, Action::SPLIT}));
+}
+
+TEST_F(SolverTest, SurrenderOnlyWhenRulesAllow) {
+  State hard16vs10(16, 10, false, false, true);
+  EXPECT_NE(vegas.bestAction(hard16vs10), Action::SURRENDER);
+
+  StrategySolver ac(GameRules::atlanticCity());
+  EXPECT_EQ(ac.bestAction(hard16vs10), Action::SURRENDER);
+}
+
+TEST_F(SolverTest, StandEvOrdering) {
+  State s20(20, 6, false);
+  State s17(17, 6, false);
+  EXPECT_GT(vegas.expectedValue(s20, Action::STAND), 0.0);
+  EXPECT_GT(vegas.expectedValue(s20, Action::STAND),
+            vegas.expectedValue(s17, Action::STAND));
+  // Doubling a hard 21 can only go down
+  EXPECT_LT(vegas.expectedValue(State(21, 6, false), Action::DOUBLE),
+            vegas.expectedValue(State(21, 6, false), Action::STAND));
+}
+
+TEST_F(SolverTest, PolicyTableMatchesBestActions) {
+  PolicyTable table = vegas.toPolicyTable();
+
+  for (int up = 1; up <= 10; ++up) {
+    for (int total = 4; total <= 21; ++total) {
+      State state(total, up, false, false, true);
+      auto legal = vegas.legalActions(state);
+      EXPECT_EQ(table.getMaxAction(state, legal), vegas.bestAction(state))
+          << state.toString();
+    }
+  }
+}
+
+TEST_F(SolverTest, SolvesFullRuleSetQuickly) {
+  auto start = std::chrono::steady_clock::now();
+  StrategySolver solver(GameRules::singleDeck());
+  solver.toPolicyTable();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                .count(),
+            1000);
+}
+
+// === Solved reference strategy ===
+
+TEST_F(SolverTest, SolvedBasicStrategyAcceptsStandForSoftDouble) {
+  training::BasicStrategy solved(StrategySolver(GameRules::singleDeck()));
+
+  // Soft 18 vs 4 doubles; the non-doubling fallback is STAND, not HIT
+  State soft18(18, 4, true);
+  ASSERT_EQ(solved.getAction(soft18), Action::DOUBLE);
+  EXPECT_TRUE(solved.isCorrectAction(soft18, Action::STAND));
+  EXPECT_FALSE(solved.isCorrectAction(soft18, Action::HIT));
+}
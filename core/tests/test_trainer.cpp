@@ -1,6 +1,10 @@
+#include "ai/MonteCarloAgent.hpp"
 #include "ai/QLearningAgent.hpp"
 #include "training/Trainer.hpp"
 #include <filesystem>
+#include <set>
+#include <tuple>
+#include <vector>
 #include <gtest/gtest.h>
 
 using namespace blackjack;
@@ -12,11 +16,43 @@ protected:
   std::shared_ptr<QLearningAgent> agent;
   TrainingConfig config;
 
-  void SetUp() override {
+  static std::shared_ptr<QLearningAgent> makeAgent() {
     QLearningAgent::Hyperparameters params;
     params.epsilon = 0.5;
     params.epsilonMin = 0.01;
-    agent = std::make_shared<QLearningAgent>(params);
+    return std::make_shared<QLearningAgent>(params);
+  }
+
+  /** Runs n episodes on both trainers in lockstep; fails at the first
+   *  episode whose reward or hand count differs. */
+  static ::testing::AssertionResult runLockstep(Trainer &a, Trainer &b,
+                                                int n) {
+    for (int i = 0; i < n; ++i) {
+      EpisodeStats sa = a.runEpisode();
+      EpisodeStats sb = b.runEpisode();
+      if (sa.reward != sb.reward || sa.handsPlayed != sb.handsPlayed) {
+        return ::testing::AssertionFailure() << "episode " << i << " differs";
+      }
+    }
+    return ::testing::AssertionSuccess();
+  }
+
+  /** Every Q-value of the hard two-card states, totals 4-21 × upcards. */
+  static std::vector<double> qGrid(const Agent &learner) {
+    std::vector<double> values;
+    for (int total = 4; total <= 21; ++total) {
+      for (int up = 1; up <= 10; ++up) {
+        State state(total, up, false, false, true);
+        for (int a = 0; a < 5; ++a) {
+          values.push_back(learner.getQValue(state, static_cast<Action>(a)));
+        }
+      }
+    }
+    return values;
+  }
+
+  void SetUp() override {
+    agent = makeAgent();
 
     auto tmpDir = std::filesystem::temp_directory_path();
     config.numEpisodes = 100;
@@ -59,9 +95,148 @@ TEST_F(TrainerTest, RunEpisodeReturnsValidStats) {
   EpisodeStats stats = trainer.runEpisode();
 
   EXPECT_GE(stats.handsPlayed, 0);
-  // Reward for an episode is +1.5, +1, 0, or -1
-  EXPECT_GE(stats.reward, -1.0);
-  EXPECT_LE(stats.reward, 1.5);
+  // Each hand scores -2 (doubled loss) .. +2 (doubled win), and splits can
+  // reach 1 + maxSplits hands, any of them doubled after the split
+  const double bound = 2.0 * (1 + config.gameRules.maxSplits);
+  EXPECT_GE(stats.reward, -bound);
+  EXPECT_LE(stats.reward, bound);
+}
+
+TEST_F(TrainerTest, SeededTrainingIsReproducible) {
+  config.seed = 1234u;
+  auto first = makeAgent(), second = makeAgent();
+  Trainer a(first, config), b(second, config);
+
+  ASSERT_TRUE(runLockstep(a, b, 2000));
+  EXPECT_EQ(qGrid(*first), qGrid(*second));
+}
+
+TEST_F(TrainerTest, SeededReplayIsReproducible) {
+  config.seed = 77u;
+  config.replayCapacity = 256;
+  config.replayBatch = 16;
+  config.replayRarePriority = 4.0;
+  auto first = makeAgent(), second = makeAgent(), plain = makeAgent();
+  TrainingConfig plainConfig = config;
+  plainConfig.replayCapacity = 0;
+  Trainer a(first, config), b(second, config), c(plain, plainConfig);
+
+  ASSERT_TRUE(runLockstep(a, b, 500));
+  for (int i = 0; i < 500; ++i) {
+    c.runEpisode();
+  }
+  EXPECT_EQ(qGrid(*first), qGrid(*second));
+  EXPECT_NE(qGrid(*first), qGrid(*plain));
+}
+
+TEST_F(TrainerTest, SeededExploringStartsAreReproducible) {
+  config.seed = 99u;
+  config.exploringStarts = StartMode::COVERAGE;
+  config.exploringStartsFraction = 1.0;
+  auto first = makeAgent(), second = makeAgent();
+  Trainer a(first, config), b(second, config);
+
+  ASSERT_TRUE(runLockstep(a, b, 10000));
+  // Every start is a chosen cell, so the rare pairs are all reached (an ace
+  // up ends a third of its rounds on the dealer's blackjack; left out)
+  for (int card = 1; card <= 10; ++card) {
+    for (int up = 2; up <= 10; ++up) {
+      int total = card == 1 ? 12 : 2 * card;
+      State pair(total, up, card == 1, true, true);
+      pair.cardCount = 2;
+      EXPECT_GT(first->getVisitCount(pair, Action::STAND) +
+                    first->getVisitCount(pair, Action::HIT) +
+                    first->getVisitCount(pair, Action::DOUBLE) +
+                    first->getVisitCount(pair, Action::SPLIT),
+                0.0)
+          << "pair of " << card << " vs " << up;
+    }
+  }
+}
+
+TEST(ExploringStartsTest, UniformSamplingCoversEveryCell) {
+  ExploringStarts starts(StartMode::UNIFORM, GameRules{});
+  Rng rng(3);
+  std::set<std::tuple<int, int, int>> seen;
+  for (int i = 0; i < 20000; ++i) {
+    ExploringStarts::Start start = starts.sample(rng);
+    int a = start.first.getValue(), b = start.second.getValue();
+    ASSERT_FALSE(std::min(a, b) == 1 && std::max(a, b) == 10);
+    seen.insert({std::min(a, b), std::max(a, b),
+                 start.dealerUpCard.getValue()});
+  }
+  EXPECT_EQ(seen.size(), ExploringStarts::NUM_CELLS);
+}
+
+TEST(ExploringStartsTest, CellStatesFollowSplitRules) {
+  GameRules noSplits;
+  noSplits.maxSplits = 0;
+  ExploringStarts splits(StartMode::COVERAGE, GameRules{});
+  ExploringStarts starts(StartMode::COVERAGE, noSplits);
+  int pairs = 0;
+  for (size_t cell = 0; cell < ExploringStarts::NUM_CELLS; ++cell) {
+    pairs += splits.cellState(cell).canSplit;
+    EXPECT_FALSE(starts.cellState(cell).canSplit) << "cell " << cell;
+    EXPECT_TRUE(starts.cellState(cell).canDouble);
+  }
+  EXPECT_EQ(pairs, 100);
+}
+
+TEST(ExploringStartsTest, CoverageFavoursUnvisitedCells) {
+  QLearningAgent agent;
+  ExploringStarts starts(StartMode::COVERAGE, GameRules{});
+  // Every cell but 8,8 vs 6 has been learned 1000 times
+  for (size_t cell = 0; cell < ExploringStarts::NUM_CELLS; ++cell) {
+    State state = starts.cellState(cell);
+    if (state.playerTotal == 16 && state.canSplit && state.dealerUpCard == 6) {
+      continue;
+    }
+    Experience exp(state, Action::STAND, 0.0, State(), true,
+                   ActionMask::base());
+    for (int i = 0; i < 1000; ++i) {
+      agent.learn(exp);
+    }
+  }
+  starts.refresh(agent);
+
+  Rng rng(4);
+  int unvisited = 0;
+  const int draws = 2000;
+  for (int i = 0; i < draws; ++i) {
+    ExploringStarts::Start start = starts.sample(rng);
+    unvisited += start.first.getValue() == 8 && start.second.getValue() == 8 &&
+                 start.dealerUpCard.getValue() == 6;
+  }
+  // Weight 1 against 539 cells of weight 1/1001: about 65% of draws
+  EXPECT_GT(unvisited, draws / 2);
+}
+
+TEST_F(TrainerTest, TrainsMonteCarloAgent) {
+  config.numEpisodes = 2000;
+  auto mc = std::make_shared<MonteCarloAgent>();
+  Trainer trainer(mc, config);
+  TrainingMetrics metrics = trainer.train();
+  EXPECT_EQ(metrics.totalEpisodes, 2000u);
+  EXPECT_GT(mc->getStateCount(), 100u);
+}
+
+TEST_F(TrainerTest, MonteCarloAgentSkipsReplay) {
+  // A replay sample would splice unrelated steps into the agent's episode;
+  // the trainer leaves replay off, so training matches a replay-free run
+  config.seed = 31u;
+  config.numEpisodes = 500;
+  TrainingConfig replayConfig = config;
+  replayConfig.replayCapacity = 256;
+  replayConfig.replayBatch = 16;
+  auto withReplay = std::make_shared<MonteCarloAgent>();
+  auto without = std::make_shared<MonteCarloAgent>();
+  EXPECT_FALSE(withReplay->supportsReplay());
+  Trainer a(withReplay, replayConfig), b(without, config);
+
+  ASSERT_TRUE(runLockstep(a, b, 500));
+  EXPECT_EQ(withReplay->getExplorationRate(), without->getExplorationRate());
+  EXPECT_EQ(withReplay->getStateCount(), without->getStateCount());
+  EXPECT_EQ(qGrid(*withReplay), qGrid(*without));
 }
 
 TEST_F(TrainerTest, TerminalRewardOnLastExperience) {
@@ -106,3 +281,47 @@ TEST_F(TrainerTest, CheckpointSavingCreatesFiles) {
   }
   EXPECT_TRUE(foundCheckpoint);
 }
+
+TEST_F(TrainerTest, ParallelTrainingCompletesRequestedEpisodes) {
+  config.numThreads = 4;
+  config.numEpisodes = 2000;
+  config.evalFrequency = 500;
+  config.checkpointFrequency = 1000;
+
+  Trainer trainer(agent, config);
+  EXPECT_EQ(trainer.getNumWorkers(), 4u);
+  TrainingMetrics metrics = trainer.train();
+
+  EXPECT_EQ(metrics.totalEpisodes, config.numEpisodes);
+  EXPECT_GT(agent->getStateCount(), 0u);
+  // Evaluation cadence is preserved: 4 periodic evaluations + final one
+  EXPECT_EQ(trainer.getHistory().size(), 5u);
+}
+
+TEST_F(TrainerTest, AsyncEvaluationRecordsEveryEvaluation) {
+  config.asyncEvaluation = true;
+  config.numEpisodes = 1000;
+  config.evalFrequency = 250;
+
+  Trainer trainer(agent, config);
+  TrainingMetrics metrics = trainer.train();
+
+  EXPECT_EQ(metrics.totalEpisodes, config.numEpisodes);
+  // 4 background evaluations (tagged with their snapshot episode) + final
+  const auto &history = trainer.getHistory();
+  ASSERT_EQ(history.size(), 5u);
+  EXPECT_EQ(history[0].totalEpisodes, 250u);
+  EXPECT_EQ(history[3].totalEpisodes, 1000u);
+}
+
+TEST_F(TrainerTest, AsyncEvaluationStillStopsEarly) {
+  config.asyncEvaluation = true;
+  config.earlyStoppingPatience = 1;
+  config.evalFrequency = 10;
+  config.numEpisodes = 100000;
+
+  Trainer trainer(agent, config);
+  TrainingMetrics metrics = trainer.train();
+
+  EXPECT_LT(metrics.totalEpisodes, 100000u);
+}